@@ -1,20 +1,36 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "../common/adjacency.h"
 
-// Maximum number of vertices
-#define NMAX 100
 #define DEBUG 0
 
+// Arrays are sized at run time and only grow, so graphs of similar size reuse them
 int numVertices;
-int degrees[NMAX];
-int adjList[NMAX][NMAX];
-int adjMatrix[NMAX][NMAX];
+int* degrees;
+int** adjList; // Row i points at the neighbours of vertex i in adjEntries
+int* adjEntries; // Neighbours of all vertices, back to back
+int* sortedEntries; // adjEntries with each row in ascending order
+int* revStart; // Vertices with an edge to vertex j are revEntries[revStart[j]] to revEntries[revStart[j + 1] - 1]
+int* revEntries; // Reverse edges, each row in ascending order
+int* fillPos; // Next free slot of each row while the lists above are filled
+int* rowStamp; // Row number + 1 of the last row a vertex was seen in, to find multiple edges
 int sizeOfDomSet;
-int domSet[NMAX];
-int dominatedVertices[NMAX];
+int* domSet;
+uint64_t* dominatedBits; // Bit v of word v / 64 is set once vertex v is dominated
+int vertexCapacity = 0; // Number of vertices the arrays have room for
+int entryCapacity = 0; // Number of neighbours adjEntries has room for
 int graphNum = 0;
 int verbosity;
 
+void reserve_vertices();
+
+void reserve_entries(int numEntries);
+
 void initialize_data_structures();
 
 void print_graph();
@@ -25,8 +41,14 @@ void print_proposed_dominating_set();
 
 int check_certificate_validity();
 
+void sort_adjacency_lists();
+
+int first_asymmetric_entry(int i, int* forward);
+
 void check_dominating_set();
 
+int first_undominated_vertex();
+
 int main(int argc, char *argv[])
 {
 	// Prints error message if incorrect usage
@@ -40,50 +62,65 @@ int main(int argc, char *argv[])
 	verbosity = atoi(argv[1]);
 
 	// Reads in input as long as end of file is not reached
-	while (fscanf(stdin, "%d", &numVertices) == 1)
+	while (read_int(&numVertices) == 1)
 	{
 		int i, j;
+		int numEntries = 0;
 
 		// Increments the number of graph
 		graphNum++;
 
 		// Prints error message if invalid number of vertices
-		if (numVertices < 1 || numVertices > NMAX)
+		if (numVertices < 1)
 		{
-			printf("Invalid input.\nThe number of vertices in a graph must be >= 1 and <= %d.\n", NMAX);
+			printf("Invalid input.\nThe number of vertices in a graph must be >= 1.\n");
 			printf("Graph     %d: BAD GRAPH\n", graphNum);
 			exit(1);
 		}
 
-		// Initializes array-based data structures to 0
+		// Makes room for the graph and initializes array-based data structures to 0
+		reserve_vertices();
 		initialize_data_structures();
 
 		// For each vertex
 		for (i = 0; i < numVertices; i++)
 		{
 			// Reads in its degree
-			if (scanf("%d", &degrees[i]) != 1 || degrees[i] < 0 || degrees[i] > numVertices - 1)
+			if (read_int(&degrees[i]) != 1 || degrees[i] < 0 || degrees[i] > numVertices - 1)
 			{
 				printf("Invalid input.\nThe value of a degree must be between 0 and %d.\n", numVertices - 1);
 				printf("Graph     %d: BAD GRAPH \n", graphNum);
 				exit(1);
 			}
 
+			// The number of edges is only known at the end, so adjEntries grows as rows come in
+			reserve_entries(numEntries + degrees[i]);
+
 			// For each degree
 			for (j = 0; j < degrees[i]; j++)
 			{
 				// Reads in the vertex's neighbours
-				if (scanf("%d", &adjList[i][j]) != 1 || adjList[i][j] < 0 || adjList[i][j] > numVertices - 1)
+				if (read_int(&adjEntries[numEntries + j]) != 1 || adjEntries[numEntries + j] < 0
+					|| adjEntries[numEntries + j] > numVertices - 1)
 				{
 					printf("Invalid input.\nA vertex must be numbered between 0 and %d.\n", numVertices - 1);
 					printf("Graph     %d: BAD GRAPH \n", graphNum);
 					exit(1);
 				}
 			}
+			numEntries += degrees[i];
+		}
+
+		// adjEntries no longer moves, so the rows can point into it
+		numEntries = 0;
+		for (i = 0; i < numVertices; i++)
+		{
+			adjList[i] = adjEntries + numEntries;
+			numEntries += degrees[i];
 		}
 
 		// Reads in the size of proposed dominating set
-		if (scanf("%d", &sizeOfDomSet) != 1 || sizeOfDomSet < 1 || sizeOfDomSet > numVertices)
+		if (read_int(&sizeOfDomSet) != 1 || sizeOfDomSet < 1 || sizeOfDomSet > numVertices)
 		{
 			printf("Invalid input.\nThe size of the dominating set must be >= 1 and <= %d.\n", numVertices);
 			printf("Graph     %d: BAD GRAPH \n", graphNum);
@@ -93,7 +130,7 @@ int main(int argc, char *argv[])
 		// Reads in each vertex in proposed dominating set
 		for (i = 0; i < sizeOfDomSet; i++)
 		{
-			if (scanf("%d", &domSet[i]) != 1)
+			if (read_int(&domSet[i]) != 1)
 			{
 				printf("Invalid input.\nA vertex must be numbered between 0 and %d.\n", numVertices - 1);
 				printf("Ensure the proposed dominating set matches its size.\n");
@@ -149,19 +186,19 @@ int main(int argc, char *argv[])
 			printf("%d ", domSet[i]);
 		}
 		printf("\n");
-		printf("Printing adjMatrix[][]\n");
+		printf("Printing revEntries[]\n");
 		for (i = 0; i < numVertices; i++)
 		{
-			for (j = 0; j < numVertices; j++)
+			for (j = revStart[i]; j < revStart[i + 1]; j++)
 			{
-				printf("%d ", adjMatrix[i][j]);
+				printf("%d ", revEntries[j]);
 			}
 			printf("\n");
 		}
-		printf("Printing dominatedVertices[]\n");
+		printf("Printing dominatedBits[]\n");
 		for (i = 0; i < numVertices; i++)
 		{
-			printf("%d ", dominatedVertices[i]);
+			printf("%d ", (int)(dominatedBits[i / 64] >> (i % 64) & 1));
 		}
 		printf("\n");
 #endif
@@ -169,24 +206,52 @@ int main(int argc, char *argv[])
 	return 0;
 }
 
+/*
+ * Makes room for numVertices vertices
+ */
+void reserve_vertices()
+{
+	if (numVertices > vertexCapacity)
+	{
+		degrees = resize_array(degrees, numVertices, sizeof(int));
+		adjList = resize_array(adjList, numVertices, sizeof(int*));
+		domSet = resize_array(domSet, numVertices, sizeof(int));
+		dominatedBits = resize_array(dominatedBits, (numVertices + 63) / 64, sizeof(uint64_t));
+		revStart = resize_array(revStart, numVertices + 1, sizeof(int));
+		fillPos = resize_array(fillPos, numVertices, sizeof(int));
+		rowStamp = resize_array(rowStamp, numVertices, sizeof(int));
+		vertexCapacity = numVertices;
+	}
+}
+
+/*
+ * Makes room for numEntries neighbours in adjEntries
+ */
+void reserve_entries(int numEntries)
+{
+	if (numEntries > entryCapacity)
+	{
+		entryCapacity = numEntries > 2 * entryCapacity ? numEntries : 2 * entryCapacity;
+		adjEntries = resize_array(adjEntries, entryCapacity, sizeof(int));
+		sortedEntries = resize_array(sortedEntries, entryCapacity, sizeof(int));
+		revEntries = resize_array(revEntries, entryCapacity, sizeof(int));
+	}
+}
+
 /*
  * Initializes parts of array-based data structures we will be using to 0
  */
 void initialize_data_structures()
 {
-	int i, j;
+	int i;
 
 	for (i = 0; i < numVertices; i++)
 	{
 		degrees[i] = 0;
 		domSet[i] = 0;
-		dominatedVertices[i] = 0;
-		for (j = 0; j < numVertices; j++)
-		{
-			adjList[i][j] = 0;
-			adjMatrix[i][j] = 0;
-		}
+		rowStamp[i] = 0;
 	}
+	memset(dominatedBits, 0, (numVertices + 63) / 64 * sizeof(uint64_t));
 }
 
 /*
@@ -227,60 +292,50 @@ void print_graph()
  * Checks the validity of a graph and aborts program if illegal.
  * Examples include graphs with asymmetric adjacency matrices
  * (e.g., digraphs) and multigraphs
+ * The adjacency matrix is never built: symmetry is checked by comparing each sorted adjacency
+ * list with the sorted list of reverse edges, in O(n + m) time and memory.
  */
 int check_graph_validity()
 {
-	int i, j, k, l;
+	int i, j, k, forward;
+
+	sort_adjacency_lists();
 
-	// Creates adjacency matrix from adjacency list
+	// Checks matrix for symmetry, reporting the first asymmetric entry in row-major order
 	for (i = 0; i < numVertices; i++)
 	{
-		for (j = 0; j < numVertices; j++)
+		j = first_asymmetric_entry(i, &forward);
+		if (j >= 0)
 		{
-			// Sets 1s on the diagonal as a vertex dominates itself
-			if (i == j)
+			if (verbosity == 0)
 			{
-				adjMatrix[i][j] = 1;
+				printf("    %d %d\n", graphNum, -1);
+				exit(1);
 			}
-			// Sets 1s to denote edges between vertices
-			if (j < degrees[i])
+			if (verbosity == 1)
 			{
-				adjMatrix[i][adjList[i][j]] = 1;
+				printf("*** Error- adjacency matrix is not symmetric: A[ %d][ %d] = %d, A[ %d][ %d] = %d\n",
+					   i, j, forward, j, i, !forward);
+				printf("Graph     %d: BAD GRAPH \n", graphNum);
+				exit(1);
 			}
 		}
 	}
 
-	// Checks matrix for symmetry
+	// Inspects adjacency list row by row
 	for (i = 0; i < numVertices; i++)
 	{
-		for (j = 0; j < numVertices; j++)
+		int* adjListRow = adjList[i];
+		int firstDuplicate = degrees[i]; // First position whose neighbour appears again later in the row
+
+		// A neighbour seen again while scanning from the right has a later duplicate
+		for (k = degrees[i] - 1; k >= 0; k--)
 		{
-			if (adjMatrix[i][j] != adjMatrix[j][i])
+			if (rowStamp[adjListRow[k]] == i + 1)
 			{
-				if (verbosity == 0)
-				{
-					printf("    %d %d\n", graphNum, -1);
-					exit(1);
-				}
-				if (verbosity == 1)
-				{
-					printf("*** Error- adjacency matrix is not symmetric: A[ %d][ %d] = %d, A[ %d][ %d] = %d\n",
-						   i, j, adjMatrix[i][j], j, i, adjMatrix[j][i]);
-					printf("Graph     %d: BAD GRAPH \n", graphNum);
-					exit(1);
-				}
+				firstDuplicate = k;
 			}
-		}
-	}
-
-	// Inspects adjacency list row by row
-	int adjListRow[NMAX];
-
-	for (i = 0; i < numVertices; i++)
-	{
-		for (j = 0; j < degrees[i]; j++)
-		{
-			adjListRow[j] = adjList[i][j];
+			rowStamp[adjListRow[k]] = i + 1;
 		}
 
 		for (k = 0; k < degrees[i]; k++)
@@ -302,21 +357,18 @@ int check_graph_validity()
 			}
 
 			// Detects multiple edges
-			for (l = k + 1; l < degrees[i]; l++)
+			if (k == firstDuplicate)
 			{
-				if (adjListRow[k] == adjListRow[l])
+				if (verbosity == 0)
+				{
+					printf("    %d %d\n", graphNum, -1);
+					exit(1);
+				}
+				if (verbosity == 1)
 				{
-					if (verbosity == 0)
-					{
-						printf("    %d %d\n", graphNum, -1);
-						exit(1);
-					}
-					if (verbosity == 1)
-					{
-						printf("*** Error- Multiple edges found connecting vertex %d to vertex %d\n", i, adjListRow[k]);
-						printf("Graph     %d: BAD GRAPH \n", graphNum);
-						exit(1);
-					}
+					printf("*** Error- Multiple edges found connecting vertex %d to vertex %d\n", i, adjListRow[k]);
+					printf("Graph     %d: BAD GRAPH \n", graphNum);
+					exit(1);
 				}
 			}
 		}
@@ -324,6 +376,97 @@ int check_graph_validity()
 	return 0;
 }
 
+/*
+ * Fills sortedEntries with every adjacency list in ascending order and revEntries with the
+ * vertices that have an edge to each vertex, also in ascending order
+ * Both are counting sorts: scanning the rows in order lists the reverse edges of each vertex in
+ * ascending order, and scanning the reverse edges in order does the same for the rows.
+ */
+void sort_adjacency_lists()
+{
+	int i, j, numEntries = 0;
+
+	for (i = 0; i <= numVertices; i++)
+	{
+		revStart[i] = 0;
+	}
+	for (i = 0; i < numVertices; i++)
+	{
+		for (j = 0; j < degrees[i]; j++)
+		{
+			revStart[adjList[i][j] + 1]++;
+		}
+	}
+	for (i = 0; i < numVertices; i++)
+	{
+		revStart[i + 1] += revStart[i];
+		fillPos[i] = revStart[i];
+	}
+	for (i = 0; i < numVertices; i++)
+	{
+		for (j = 0; j < degrees[i]; j++)
+		{
+			revEntries[fillPos[adjList[i][j]]++] = i;
+		}
+	}
+
+	for (i = 0; i < numVertices; i++)
+	{
+		fillPos[i] = numEntries;
+		numEntries += degrees[i];
+	}
+	for (j = 0; j < numVertices; j++)
+	{
+		for (i = revStart[j]; i < revStart[j + 1]; i++)
+		{
+			sortedEntries[fillPos[revEntries[i]]++] = j;
+		}
+	}
+}
+
+/*
+ * Returns the smallest j such that exactly one of A[i][j] and A[j][i] is 1, or -1 if row i and
+ * column i of the adjacency matrix agree; *forward is set to A[i][j]
+ * Merges the sorted adjacency list of i with its sorted reverse edges, skipping repeated
+ * neighbours and i itself, as the diagonal is 1 on both sides.
+ */
+int first_asymmetric_entry(int i, int* forward)
+{
+	int a = adjList[i] - adjEntries; // Position in the sorted row
+	int aEnd = a + degrees[i];
+	int b = revStart[i]; // Position in the reverse edges
+	int bEnd = revStart[i + 1];
+
+	for (;;)
+	{
+		while (a < aEnd && (sortedEntries[a] == i || (a > adjList[i] - adjEntries && sortedEntries[a] == sortedEntries[a - 1])))
+		{
+			a++;
+		}
+		while (b < bEnd && (revEntries[b] == i || (b > revStart[i] && revEntries[b] == revEntries[b - 1])))
+		{
+			b++;
+		}
+
+		if (a == aEnd && b == bEnd)
+		{
+			return -1;
+		}
+		if (b == bEnd || (a < aEnd && sortedEntries[a] < revEntries[b]))
+		{
+			*forward = 1;
+			return sortedEntries[a];
+		}
+		if (a == aEnd || revEntries[b] < sortedEntries[a])
+		{
+			*forward = 0;
+			return revEntries[b];
+		}
+		a++;
+		b++;
+	}
+}
+
 /*
  * Prints proposed dominating set
  */
@@ -344,7 +487,7 @@ void print_proposed_dominating_set()
  */
 int check_certificate_validity()
 {
-	int i, j;
+	int i;
 
 	for (i = 0; i < sizeOfDomSet; i++)
 	{
@@ -369,40 +512,28 @@ int check_certificate_validity()
 
 /*
  * Checks that every vertex is dominated
+ * The closed neighbourhoods of the certificate vertices are ORed into one bitset, then the bitset
+ * is tested for all ones, so the check costs O(n / 64 + the sum of their degrees)
  */
 void check_dominating_set()
 {
 	int i, j, err;
 
-	// Populates dominatedVertices[] with data
+	// Populates dominatedBits[] with the union of the closed neighbourhoods
 	for (i = 0; i < sizeOfDomSet; i++)
 	{
-		dominatedVertices[domSet[i]] = 1;
-	}
+		int* adjListRow = adjList[domSet[i]];
 
-	for (i = 0; i < sizeOfDomSet; i++)
-	{
-		for (j = 0; j < numVertices; j++)
+		dominatedBits[domSet[i] / 64] |= 1ULL << (domSet[i] % 64);
+		for (j = 0; j < degrees[domSet[i]]; j++)
 		{
-			if (adjMatrix[domSet[i]][j] == 1)
-			{
-				dominatedVertices[j] = 1;
-			}
+			dominatedBits[adjListRow[j] / 64] |= 1ULL << (adjListRow[j] % 64);
 		}
 	}
 
-	for (i = 0; i < numVertices; i++)
-	{
-		if (dominatedVertices[i] != 1)
-		{
-			err = 1;
-			break;
-		}
-		else
-		{
-			err = 0;
-		}
-	}
+	i = first_undominated_vertex();
+	err = i >= 0;
+
 	if (err == 1)
 	{
 		if (verbosity == 0)
@@ -428,4 +559,45 @@ void check_dominating_set()
 			printf("=============================\n");
 		}
 	}
-}
\ No newline at end of file
+}
+
+/*
+ * Returns the first vertex whose bit is not set in dominatedBits, or -1 if every vertex is dominated
+ */
+int first_undominated_vertex()
+{
+	int numWords = numVertices / 64; // Words in which every bit is a vertex
+	int w = 0;
+
+#ifdef __SSE2__
+	// Two words at a time: all ones compares equal to all ones in every byte
+	for (; w + 2 <= numWords; w += 2)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(dominatedBits + w));
+
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(-1))) != 0xffff)
+		{
+			break;
+		}
+	}
+#endif
+	for (; w < numWords; w++)
+	{
+		if (dominatedBits[w] != ~0ULL)
+		{
+			return w * 64 + __builtin_ctzll(~dominatedBits[w]);
+		}
+	}
+
+	// The last word only holds the vertices left over
+	if (numVertices % 64 != 0)
+	{
+		uint64_t missing = ~dominatedBits[numWords] & ((1ULL << (numVertices % 64)) - 1);
+
+		if (missing != 0)
+		{
+			return numWords * 64 + __builtin_ctzll(missing);
+		}
+	}
+	return -1;
+}
@@ -111,5 +111,9 @@ int read_params(FILE *fp, int *n, int *graph_num, int *k)
          printf("Error- Failed to read in dominating set size.\n");
          return(0);
     }
+    /* Skip extra columns, e.g. the lower bound and status of solvers run with a time limit */
+    int c;
+    while ((c= getc(fp)) != '\n' && c != EOF)
+        ;
     return(1);
 }
@@ -1,112 +1,449 @@
 /*
  * This program reads in a combination of permutations and dominating sets and maps the dominating sets to the permutations.
+ * Input: provided through standard input
+ *        Format: number of vertices n, group order, the elements of the group as permutations of 0..n-1,
+ *        then the dominating sets, each as its size followed by its vertices. The sets all have the size
+ *        of the first one, and a row that starts with any other number starts the next input.
+ *        With --generators, the group order is replaced by the number of generators k, and only
+ *        k generating permutations are listed. The group is then built as a base and strong generating
+ *        set (Schreier-Sims) and its elements are listed on the fly instead of being stored.
+ * Usage: a.out [--generators] [--orbits | --burnside] [--threads k] [--binary] < in_c11.txt
+ *        Images are printed one per line, formatted into a large buffer rather than with printf. With
+ *        --binary they are written as binary records instead (see common/out_writer.h): each image as
+ *        varints of its size, its first vertex and the gaps between its vertices, and an empty record
+ *        after the images of each dominating set.
+ *        With --orbits, each dominating set is replaced by its canonical form, the lexicographically
+ *        smallest of its sorted images, and only one set per orbit is printed: the orbit number, the
+ *        orbit size (group order / number of permutations mapping the set onto itself), the number of
+ *        input sets in the orbit, then the canonical form. The sets are spread over k threads.
+ *        Sets are kept as bitsets of vertices, so an image comes out sorted without a sort step. In orbit
+ *        mode each permutation is first compiled into one lookup table per byte of a bitset, giving the
+ *        image of every value of that byte, and a set's image is the OR of one entry per byte. The tables
+ *        are compiled once, shared by the threads, for a block of permutations at a time.
+ *        With --burnside, no image is listed at all. Each set only has its stabilizer counted, testing
+ *        every permutation for whether it maps the set into itself, and the orbits are counted with
+ *        Burnside's lemma: the number of orbits is the sum of the stabilizer sizes divided by the group
+ *        order. If every set contains some vertex v, the sets are taken to be those through v of a
+ *        family closed under the group, and each set counts for |orbit of v| / |set meets orbit of v|.
+ *        The output gives, for each stabilizer size, the orbit size and the number of orbits and sets.
+ * Compile: gcc -O2 -pthread Scott5.c
  */
 
-#include <stdio.h> 
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <pthread.h>
+#include "../common/int_reader.h"
+#include "../common/perm_group.h"
+#include "../common/out_writer.h"
 
-#define MAXMDSSIZE 28  // add extra 1 for dom set size -> c_06 9, c_09 19, c_11 28
-#define NUMDOMSETS 1404 // number of dominating sets -> c_06 18, c_09 36, c_11 1404
-#define ROWS 968 // group order -> c_06 288, c_09 648, c_11 968
-#define COLS 121 // n vertices in a k x k cycle graph -> c_06 36, c_09 81, c_11 121
 #define DEBUG 0
+#define THREAD_MAX 256 // maximum number of threads in orbit mode
+#define WORD_BITS 64 // vertices per word of a bitset
+#define TABLE_BLOCK_BYTES (64 << 20) // memory for the byte tables of the permutations compiled at once
 
-int read_input(int* n, int* group_order, int G[ROWS][COLS], int min_dom_set[NUMDOMSETS][MAXMDSSIZE]);
-void print_permutations(int G[ROWS][COLS]);
-void print_min_dom_sets(int min_dom_set[NUMDOMSETS][MAXMDSSIZE]);
-void map_automorphisms(int G[ROWS][COLS], int min_dom_set[NUMDOMSETS][MAXMDSSIZE]);
-int cmpfunc (const void * a, const void * b);
-void print_vector (int size, int arr[]);
+/*
+ * Permutations and dominating sets of one input, sized at run time
+ */
+struct input
+{
+    int n; // number of vertices
+    int group_order; // number of elements of the group
+    int generators; // 1 if G holds generators of the group, 0 if it holds every element
+    int n_perms; // number of permutations in G
+    int* G; // permutation k maps vertex j to G[k * n + j]
+    size_t G_cap; // entries G has room for
+    struct perm_group group; // base and strong generating set, with --generators
+    int set_size; // number of vertices in each dominating set
+    int n_sets; // number of dominating sets
+    int* min_dom_set; // set i is row i of set_size + 1 entries: its size, then its vertices
+    size_t sets_cap; // entries min_dom_set has room for
+};
+
+/*
+ * Position in the list of elements of the group
+ */
+struct group_iter
+{
+    struct perm_iter it; // position in the base and strong generating set, with --generators
+    int k; // index of the next permutation of G otherwise
+};
 
-int main()
+/*
+ * State the threads share while canonicalizing the dominating sets in orbit mode
+ * The group is compiled into byte tables a block of permutations at a time, once for all threads.
+ */
+struct orbit_state
 {
-	int n; // number of vertices
-	int group_order;
-	int G[ROWS][COLS]; // graph matrix
-    int min_dom_set[NUMDOMSETS][MAXMDSSIZE]; // dom set matrix
-	
+    int words; // words in a bitset
+    int n_bytes; // bytes in a bitset that hold vertices
+    uint64_t* sets; // each dominating set as a bitset, words entries per set
+    uint64_t* canon; // smallest image of each set found so far, as a bitset
+    int n_perms; // permutations in the current block
+    int block_cap; // permutations a block has room for
+    int* perms; // permutation k of the block maps vertex j to perms[k * n + j]
+    uint64_t* tables; // byte tables of permutation k of the block, table_size words from k * table_size
+    size_t table_size; // words in the byte tables of one permutation
+};
+
+/*
+ * Dominating sets, or permutations of a block, handled by one thread in orbit mode
+ */
+struct orbit_job
+{
+    struct input* in;
+    struct orbit_state* state; // shared bitsets and compiled block, for canonicalizing
+    int* stabilizer; // number of permutations mapping each dominating set onto itself
+    int index; // number of the job, from 0
+    int n_jobs; // number of jobs
+    int first; // first dominating set of the job
+    int last; // one past the last dominating set of the job
+    pthread_t thread;
+};
+
+int read_input(struct input* in);
+int read_permutation(struct input* in, int k, int* seen);
+void* resize_array(void* arr, size_t count, size_t size);
+void group_iter_init(struct input* in, struct group_iter* gi);
+const int* group_next(struct input* in, struct group_iter* gi);
+void group_iter_free(struct input* in, struct group_iter* gi);
+void print_permutations(struct input* in);
+void print_min_dom_sets(struct input* in);
+void map_automorphisms(struct input* in, struct out_writer* out);
+void map_orbits(struct input* in, int n_threads, struct out_writer* out);
+void burnside_orbits(struct input* in, int n_threads);
+void run_jobs(struct input* in, int n_threads, void* (*work)(void*), struct orbit_state* state, int* stabilizer);
+void* compile_block(void* arg);
+void* canonicalize_sets(void* arg);
+void* count_stabilizers(void* arg);
+void compile_permutation(int n, const int perm[], uint64_t* table);
+int bitset_to_vector(int words, const uint64_t bits[], int arr[]);
+uint64_t hash_set(int size, int arr[]);
+void print_vector (struct out_writer* out, int size, int arr[]);
+
+int main(int argc, char *argv[])
+{
+    struct input in; // permutations and dominating sets
+    int generators = 0; // 1 if the input lists generators instead of the whole group
+    int orbits = 0; // 1 to print one canonical set per orbit, 2 to count orbits with Burnside's lemma
+    int n_threads = 1; // threads canonicalizing sets in orbit mode
+    int binary = 0; // 1 to write images as binary records
+    static struct out_writer out; // buffered standard output
+    int i;
+
+    // Reads in the options
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--generators") == 0)
+        {
+            generators = 1;
+        }
+        else if (strcmp(argv[i], "--orbits") == 0)
+        {
+            orbits = 1;
+        }
+        else if (strcmp(argv[i], "--burnside") == 0)
+        {
+            orbits = 2;
+        }
+        else if (strcmp(argv[i], "--binary") == 0)
+        {
+            binary = 1;
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            n_threads = atoi(argv[++i]);
+            if (n_threads < 1 || n_threads > THREAD_MAX)
+            {
+                printf("The number of threads must be between 1 and %d\n", THREAD_MAX);
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            printf("Unknown option %s\nOptions: --generators, --orbits, --burnside, --threads k, --binary\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (out_open(&out, stdout, 0) != 0)
+    {
+        printf("Out of memory\n");
+        return EXIT_FAILURE;
+    }
+    out.binary = binary;
+
+    memset(&in, 0, sizeof(in));
+    in.generators = generators;
+
     // Processes input
-    while (read_input(&n, &group_order, G, min_dom_set) == 0)
+    while (read_input(&in) == 0)
     {
 #if DEBUG
-        print_permutations(G);
-        print_min_dom_sets(min_dom_set);
+        print_permutations(&in);
+        print_min_dom_sets(&in);
 #endif
-        map_automorphisms(G, min_dom_set);
+        if (orbits == 2)
+        {
+            burnside_orbits(&in, n_threads);
+        }
+        else if (orbits)
+        {
+            map_orbits(&in, n_threads, &out);
+        }
+        else
+        {
+            map_automorphisms(&in, &out);
+        }
     }
 
+    out_close(&out);
+    free(in.G);
+    free(in.min_dom_set);
+    perm_group_free(&in.group);
+
 	return EXIT_SUCCESS;
 }
 
 /*
  * Reads in a graph from standard input
  */
-int read_input(int* n, int* group_order, int G[ROWS][COLS], int min_dom_set[NUMDOMSETS][MAXMDSSIZE]) 
+int read_input(struct input* in)
 {
+    static int pending = -1; // first number of the next input, when it was read as a set size
+    int* seen; // stamp of the vertices of a permutation, or negated, of a set
+    int i, j, size;
+
     // Reads in input as long as end of file is not reached
-	if (fscanf(stdin, "%d", n) == 1)
-	{
-        if (scanf("%d", group_order) != 1)
-		{
+    if (pending >= 0)
+    {
+        in->n = pending;
+        pending = -1;
+    }
+    else if (read_int(&in->n) != 1)
+    {
+        return EXIT_FAILURE;
+    }
+    if (read_int(&in->n_perms) != 1 || in->n < 1 || in->n_perms < 1)
+    {
+        printf("Invalid input.\nThe number of vertices and of permutations must be >= 1.\n");
+        return EXIT_FAILURE;
+    }
+
+    if ((size_t)in->n_perms * in->n > in->G_cap)
+    {
+        in->G_cap = (size_t)in->n_perms * in->n;
+        in->G = resize_array(in->G, in->G_cap, sizeof(int));
+    }
+    seen = calloc(in->n, sizeof(int));
+    if (seen == NULL)
+    {
+        printf("Out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < in->n_perms; i++)
+    {
+        if (read_permutation(in, i, seen) != 0)
+        {
+            free(seen);
             return EXIT_FAILURE;
-		}
-		int i, j;
-
-		for (i = 0; i < ROWS; i++)
-		{
-			for (j = 0; j < COLS; j++)
-			{
-				if (scanf("%d", &G[i][j]) != 1)
-				{
-                    
-				    return EXIT_FAILURE;
-				}			    
-			}            
-		}
-        for (i = 0; i < NUMDOMSETS; i++)
-        {
-            for (j = 0; j < MAXMDSSIZE; j++)
-            {
-                if (scanf("%d", &min_dom_set[i][j]) != 1)
-                {
+        }
+    }
 
-                    return EXIT_FAILURE;
-                }
+    // the group is listed in full, or built from its generators
+    if (in->generators)
+    {
+        perm_group_free(&in->group);
+        if (perm_group_init(&in->group, in->n) != 0)
+        {
+            printf("Out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+        for (i = 0; i < in->n_perms; i++)
+        {
+            if (perm_group_add(&in->group, in->G + (size_t)i * in->n) != 0)
+            {
+                printf("Out of memory\n");
+                exit(EXIT_FAILURE);
             }
-        }       
-        return EXIT_SUCCESS;
-	}
-    return EXIT_FAILURE;
+        }
+        if (perm_group_order(&in->group) > INT_MAX)
+        {
+            printf("The group has more than %d elements\n", INT_MAX);
+            free(seen);
+            return EXIT_FAILURE;
+        }
+        in->group_order = (int)perm_group_order(&in->group);
+    }
+    else
+    {
+        in->group_order = in->n_perms;
+    }
+
+    // the sets continue as long as rows start with the size of the first one
+    in->n_sets = 0;
+    in->set_size = -1;
+    while (read_int(&size) == 1)
+    {
+        if (in->set_size < 0)
+        {
+            if (size < 1 || size > in->n)
+            {
+                printf("Invalid input.\nThe size of a dominating set must be between 1 and %d.\n", in->n);
+                free(seen);
+                return EXIT_FAILURE;
+            }
+            in->set_size = size;
+        }
+        else if (size != in->set_size)
+        {
+            pending = size;
+            break;
+        }
+
+        if ((size_t)(in->n_sets + 1) * (in->set_size + 1) > in->sets_cap)
+        {
+            in->sets_cap = 2 * (size_t)(in->n_sets + 1) * (in->set_size + 1);
+            in->min_dom_set = resize_array(in->min_dom_set, in->sets_cap, sizeof(int));
+        }
+        int* row = in->min_dom_set + (size_t)in->n_sets * (in->set_size + 1);
+        row[0] = size;
+        for (j = 1; j <= size; j++)
+        {
+            if (read_int(&row[j]) != 1 || row[j] < 0 || row[j] >= in->n)
+            {
+                printf("Invalid input.\nDominating set %d: a vertex must be between 0 and %d.\n", in->n_sets + 1, in->n - 1);
+                free(seen);
+                return EXIT_FAILURE;
+            }
+            // a repeated vertex would leave the set with fewer bits than its size
+            if (seen[row[j]] == -(in->n_sets + 1))
+            {
+                printf("Invalid input.\nDominating set %d: vertex %d appears more than once.\n", in->n_sets + 1, row[j]);
+                free(seen);
+                return EXIT_FAILURE;
+            }
+            seen[row[j]] = -(in->n_sets + 1);
+        }
+        in->n_sets++;
+    }
+    free(seen);
+    if (in->n_sets == 0)
+    {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Reads in permutation k, checking that it maps 0..n-1 onto itself
+ * Returns EXIT_FAILURE on truncated input or if it is not a permutation
+ */
+int read_permutation(struct input* in, int k, int* seen)
+{
+    int* perm = in->G + (size_t)k * in->n;
+    int j;
+
+    for (j = 0; j < in->n; j++)
+    {
+        if (read_int(&perm[j]) != 1)
+        {
+            return EXIT_FAILURE;
+        }
+        if (perm[j] < 0 || perm[j] >= in->n || seen[perm[j]] == k + 1)
+        {
+            printf("Invalid input.\nPermutation %d is not a permutation of 0..%d.\n", k + 1, in->n - 1);
+            return EXIT_FAILURE;
+        }
+        seen[perm[j]] = k + 1;
+    }
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Resizes an array to count elements of the given size, exiting if there is not enough memory
+ */
+void* resize_array(void* arr, size_t count, size_t size)
+{
+    arr = realloc(arr, count * size);
+    if (arr == NULL && count > 0)
+    {
+        printf("Out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    return arr;
+}
+
+/*
+ * Sets up an iterator at the first element of the group
+ */
+void group_iter_init(struct input* in, struct group_iter* gi)
+{
+    memset(gi, 0, sizeof(*gi));
+    if (in->generators && perm_iter_init(&gi->it, &in->group) != 0)
+    {
+        printf("Out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*
+ * Returns the next element of the group, or NULL after the last one
+ */
+const int* group_next(struct input* in, struct group_iter* gi)
+{
+    if (in->generators)
+    {
+        return perm_group_next(&in->group, &gi->it);
+    }
+    if (gi->k == in->group_order)
+    {
+        return NULL;
+    }
+    return in->G + (size_t)gi->k++ * in->n;
+}
+
+/*
+ * Frees an iterator
+ */
+void group_iter_free(struct input* in, struct group_iter* gi)
+{
+    if (in->generators)
+    {
+        perm_iter_free(&gi->it);
+    }
 }
 
 /*
  * Prints permutations in debug mode
  */
-void print_permutations(int G[ROWS][COLS])
+void print_permutations(struct input* in)
 {
     int i, j;
-    for (i = 0; i < ROWS; i++)
+    for (i = 0; i < in->n_perms; i++)
     {
-        for (j = 0; j < COLS; j++)
+        for (j = 0; j < in->n; j++)
         {
-            printf("%d ", G[i][j]);
+            printf("%d ", in->G[(size_t)i * in->n + j]);
         }
         printf("\n");
-    }    
+    }
     printf("\n");
 }
 
 /*
  * Prints minimum dominating sets in debug mode
  */
-void print_min_dom_sets(int min_dom_set[NUMDOMSETS][MAXMDSSIZE])
+void print_min_dom_sets(struct input* in)
 {
     int i, j;
-    for (i = 0; i < NUMDOMSETS; i++)
+    for (i = 0; i < in->n_sets; i++)
     {
-        for (j = 1; j < MAXMDSSIZE; j++)
+        for (j = 1; j <= in->set_size; j++)
         {
-            printf("%d ", min_dom_set[i][j]);
+            printf("%d ", in->min_dom_set[(size_t)i * (in->set_size + 1) + j]);
         }
         printf("\n");
     }
@@ -115,46 +452,549 @@ void print_min_dom_sets(int min_dom_set[NUMDOMSETS][MAXMDSSIZE])
 /*
  * Maps automorphisms in various permutations to the identity matrix
  */
-void map_automorphisms(int G[ROWS][COLS], int min_dom_set[NUMDOMSETS][MAXMDSSIZE])
+void map_automorphisms(struct input* in, struct out_writer* out)
 {
-    int i, j, k; 
-    int arr[MAXMDSSIZE - 1]; 
+    int i, j;
+    int words = (in->n + WORD_BITS - 1) / WORD_BITS; // words in a bitset
+    int* arr = resize_array(NULL, in->set_size + 1, sizeof(int)); // image of a set, from index 1
+    uint64_t* image = resize_array(NULL, words, sizeof(uint64_t)); // image of a set as a bitset
+    const int* perm;
+    struct group_iter gi;
+#if DEBUG
+    int k;
+#endif
 
-    for (i = 0; i < NUMDOMSETS; i++) 
+    for (i = 0; i < in->n_sets; i++)
     {
-        for (k = 0; k < ROWS; k++)
+        int* set = in->min_dom_set + (size_t)i * (in->set_size + 1);
+
+        group_iter_init(in, &gi);
+#if DEBUG
+        k = 0;
+#endif
+        while ((perm = group_next(in, &gi)) != NULL)
         {
-            for (j = 1; j < MAXMDSSIZE; j++)
+            // the bitset lists the image in increasing order
+            memset(image, 0, words * sizeof(uint64_t));
+            for (j = 1; j <= in->set_size; j++)
             {
-                arr[j] = G[k][min_dom_set[i][j]];              
+                image[perm[set[j]] / WORD_BITS] |= 1ULL << (perm[set[j]] % WORD_BITS);
             }
-            qsort(arr, MAXMDSSIZE, sizeof(int), cmpfunc);
+            bitset_to_vector(words, image, arr + 1);
 #if DEBUG
-            printf("%d  ", k);
+            out_int(out, k++);
+            out_str(out, "  ");
 #endif
-            print_vector(MAXMDSSIZE, arr);
+            if (out->binary)
+            {
+                out_set_record(out, in->set_size, arr + 1);
+            }
+            else
+            {
+                print_vector(out, in->set_size + 1, arr);
+            }
         }
-        printf("\n");
+        group_iter_free(in, &gi);
+        if (out->binary)
+        {
+            out_set_record(out, 0, arr);
+        }
+        else
+        {
+            out_char(out, '\n');
+        }
+    }
+    out_flush(out);
+    free(arr);
+    free(image);
+}
+
+/*
+ * Prints one canonical dominating set per orbit, with the orbit size and the number of input sets in it
+ * Canonical forms are computed in parallel, then deduplicated in input order with a hash set
+ */
+void map_orbits(struct input* in, int n_threads, struct out_writer* out)
+{
+    int size = in->set_size;
+    int* canon = resize_array(NULL, (size_t)in->n_sets * size, sizeof(int)); // canonical form of each set
+    int* stabilizer = resize_array(NULL, in->n_sets, sizeof(int)); // permutations mapping each set onto itself
+    int* count = resize_array(NULL, in->n_sets, sizeof(int)); // input sets in the orbit of each representative
+    int* table; // hash set of canonical forms, as indices of sets, -1 for an empty entry
+    int table_size = 1; // entries in table, a power of two at least twice the number of sets
+    struct orbit_state state; // bitsets of the sets and the compiled block of permutations
+    const int* perm;
+    struct group_iter gi;
+    int n_orbits = 0;
+    int i, j, h;
+
+    state.words = (in->n + WORD_BITS - 1) / WORD_BITS;
+    state.n_bytes = (in->n + 7) / 8;
+    state.table_size = (size_t)state.n_bytes * 256 * state.words;
+    state.block_cap = (int)(TABLE_BLOCK_BYTES / (state.table_size * sizeof(uint64_t)));
+    if (state.block_cap < 1)
+    {
+        state.block_cap = 1;
+    }
+    if (state.block_cap > in->group_order)
+    {
+        state.block_cap = in->group_order;
+    }
+    state.sets = calloc((size_t)in->n_sets * state.words, sizeof(uint64_t));
+    state.canon = resize_array(NULL, (size_t)in->n_sets * state.words, sizeof(uint64_t));
+    state.perms = resize_array(NULL, (size_t)state.block_cap * in->n, sizeof(int));
+    state.tables = resize_array(NULL, (size_t)state.block_cap * state.table_size, sizeof(uint64_t));
+    if (state.sets == NULL)
+    {
+        printf("Out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < in->n_sets; i++)
+    {
+        const int* set = in->min_dom_set + (size_t)i * (size + 1);
+
+        for (j = 1; j <= size; j++)
+        {
+            state.sets[(size_t)i * state.words + set[j] / WORD_BITS] |= 1ULL << (set[j] % WORD_BITS);
+        }
+        stabilizer[i] = 0;
+    }
+    memcpy(state.canon, state.sets, (size_t)in->n_sets * state.words * sizeof(uint64_t));
+
+    // each block is compiled by all the threads together, then applied by each to its own sets
+    group_iter_init(in, &gi);
+    do
+    {
+        for (state.n_perms = 0; state.n_perms < state.block_cap && (perm = group_next(in, &gi)) != NULL; state.n_perms++)
+        {
+            memcpy(state.perms + (size_t)state.n_perms * in->n, perm, in->n * sizeof(int));
+        }
+        run_jobs(in, n_threads, compile_block, &state, NULL);
+        run_jobs(in, n_threads, canonicalize_sets, &state, stabilizer);
+    } while (state.n_perms == state.block_cap);
+    group_iter_free(in, &gi);
+
+    for (i = 0; i < in->n_sets; i++)
+    {
+        bitset_to_vector(state.words, state.canon + (size_t)i * state.words, canon + (size_t)i * size);
+    }
+    free(state.sets);
+    free(state.canon);
+    free(state.perms);
+    free(state.tables);
+
+    while (table_size < 2 * in->n_sets)
+    {
+        table_size *= 2;
+    }
+    table = resize_array(NULL, table_size, sizeof(int));
+    for (h = 0; h < table_size; h++)
+    {
+        table[h] = -1;
+    }
+
+    // the first set with each canonical form stands for its orbit
+    for (i = 0; i < in->n_sets; i++)
+    {
+        int* c = canon + (size_t)i * size;
+
+        h = (int)(hash_set(size, c) & (table_size - 1));
+        while (table[h] >= 0 && memcmp(canon + (size_t)table[h] * size, c, size * sizeof(int)) != 0)
+        {
+            h = (h + 1) & (table_size - 1);
+        }
+        if (table[h] < 0)
+        {
+            table[h] = i;
+            count[i] = 0;
+        }
+        count[table[h]]++;
+    }
+
+    for (i = 0; i < in->n_sets; i++)
+    {
+        int* c = canon + (size_t)i * size;
+
+        h = (int)(hash_set(size, c) & (table_size - 1));
+        while (table[h] != i && memcmp(canon + (size_t)table[h] * size, c, size * sizeof(int)) != 0)
+        {
+            h = (h + 1) & (table_size - 1);
+        }
+        if (table[h] == i)
+        {
+            out_int_width(out, ++n_orbits, 4);
+            out_char(out, ' ');
+            out_int_width(out, in->group_order / stabilizer[i], 6);
+            out_char(out, ' ');
+            out_int_width(out, count[i], 4);
+            out_str(out, "  ");
+            print_vector(out, size + 1, c - 1);
+        }
+    }
+    out_flush(out);
+    printf("%d orbits of %d dominating sets\n\n", n_orbits, in->n_sets);
+
+    free(table);
+    free(canon);
+    free(stabilizer);
+    free(count);
+}
+
+/*
+ * Counts the orbits of the dominating sets with Burnside's lemma, from the stabilizer size of each set
+ * Sets with the same stabilizer size are grouped; a set with stabilizer h counts for h / group order of an
+ * orbit, scaled when the sets are only those through a common vertex
+ */
+void burnside_orbits(struct input* in, int n_threads)
+{
+    int size = in->set_size;
+    int* stabilizer = resize_array(NULL, in->n_sets, sizeof(int)); // permutations mapping each set onto itself
+    int* order = resize_array(NULL, in->n_sets, sizeof(int)); // sets by increasing stabilizer size
+    double* weight = resize_array(NULL, in->n_sets, sizeof(double)); // share of an orbit counted by each set
+    char* in_orbit = calloc(in->n, 1); // 1 for the vertices of the orbit of the common vertex
+    int* count = calloc(in->n, sizeof(int)); // number of sets containing each vertex
+    int common = -1; // vertex in every set, -1 if none
+    int orbit_size = 0; // size of the orbit of the common vertex
+    double total = 0; // number of orbits
+    const int* perm;
+    struct group_iter gi;
+    int i, j, first, meets;
+
+    if (in_orbit == NULL || count == NULL)
+    {
+        printf("Out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    run_jobs(in, n_threads, count_stabilizers, NULL, stabilizer);
+
+    // a vertex in every set means the sets are a slice of a larger family
+    for (i = 0; i < in->n_sets; i++)
+    {
+        for (j = 1; j <= size; j++)
+        {
+            count[in->min_dom_set[(size_t)i * (size + 1) + j]]++;
+        }
+    }
+    for (j = 0; j < in->n && common < 0; j++)
+    {
+        if (count[j] == in->n_sets && size < in->n)
+        {
+            common = j;
+        }
+    }
+    if (common >= 0)
+    {
+        group_iter_init(in, &gi);
+        while ((perm = group_next(in, &gi)) != NULL)
+        {
+            if (!in_orbit[perm[common]])
+            {
+                in_orbit[perm[common]] = 1;
+                orbit_size++;
+            }
+        }
+        group_iter_free(in, &gi);
+    }
+
+    for (i = 0; i < in->n_sets; i++)
+    {
+        weight[i] = (double)stabilizer[i] / in->group_order;
+        if (common >= 0)
+        {
+            const int* set = in->min_dom_set + (size_t)i * (size + 1);
+
+            for (meets = 0, j = 1; j <= size; j++)
+            {
+                meets += in_orbit[set[j]];
+            }
+            weight[i] *= (double)orbit_size / meets;
+        }
+        order[i] = i;
     }
+
+    // insertion sort by stabilizer size keeps the sets of each size together
+    for (i = 1; i < in->n_sets; i++)
+    {
+        int k = order[i];
+
+        for (j = i; j > 0 && stabilizer[order[j - 1]] > stabilizer[k]; j--)
+        {
+            order[j] = order[j - 1];
+        }
+        order[j] = k;
+    }
+
+    printf("stabilizer  orbit size  orbits    sets\n");
+    for (first = 0; first < in->n_sets; first = i)
+    {
+        double orbits = 0;
+
+        for (i = first; i < in->n_sets && stabilizer[order[i]] == stabilizer[order[first]]; i++)
+        {
+            orbits += weight[order[i]];
+        }
+        printf("%10d  %10d  %6.0f  %6d\n", stabilizer[order[first]], in->group_order / stabilizer[order[first]], orbits, i - first);
+        total += orbits;
+    }
+    if (common >= 0)
+    {
+        printf("%.0f orbits of sets through vertex %d, from %d dominating sets\n", total, common, in->n_sets);
+    }
+    else
+    {
+        printf("%.0f orbits of %d dominating sets\n", total, in->n_sets);
+    }
+    if (total - (long long)(total + 0.5) > 1e-6 || (long long)(total + 0.5) - total > 1e-6)
+    {
+        printf("The sets are not closed under the group, so the orbit count is not exact\n");
+    }
+    printf("\n");
+
+    free(stabilizer);
+    free(order);
+    free(weight);
+    free(in_orbit);
+    free(count);
 }
 
 /*
- * Sorting function
+ * Splits the dominating sets into contiguous blocks, one per thread, and runs work on each
+ * Every job also gets its number, for work that is split some other way.
  */
-int cmpfunc (const void * a, const void * b)
+void run_jobs(struct input* in, int n_threads, void* (*work)(void*), struct orbit_state* state, int* stabilizer)
 {
-   return ( *(int*)a - *(int*)b );
+    struct orbit_job jobs[THREAD_MAX];
+    int i;
+
+    for (i = 0; i < n_threads; i++)
+    {
+        jobs[i].in = in;
+        jobs[i].state = state;
+        jobs[i].stabilizer = stabilizer;
+        jobs[i].index = i;
+        jobs[i].n_jobs = n_threads;
+        jobs[i].first = (int)((long long)in->n_sets * i / n_threads);
+        jobs[i].last = (int)((long long)in->n_sets * (i + 1) / n_threads);
+    }
+    for (i = 1; i < n_threads; i++)
+    {
+        pthread_create(&jobs[i].thread, NULL, work, &jobs[i]);
+    }
+    work(&jobs[0]);
+    for (i = 1; i < n_threads; i++)
+    {
+        pthread_join(jobs[i].thread, NULL);
+    }
+}
+
+/*
+ * Compiles the job's share of the current block of permutations into byte tables: every n_jobs-th
+ * permutation, starting with permutation index
+ */
+void* compile_block(void* arg)
+{
+    struct orbit_job* job = arg;
+    struct orbit_state* state = job->state;
+    int k;
+
+    for (k = job->index; k < state->n_perms; k += job->n_jobs)
+    {
+        compile_permutation(job->in->n, state->perms + (size_t)k * job->in->n, state->tables + (size_t)k * state->table_size);
+    }
+    return NULL;
+}
+
+/*
+ * Applies the compiled block of permutations to the dominating sets of a job, keeping the smallest
+ * image of each set as its canonical form and counting the permutations that map it onto itself
+ */
+void* canonicalize_sets(void* arg)
+{
+    struct orbit_job* job = arg;
+    struct orbit_state* state = job->state;
+    int words = state->words;
+    uint64_t* image = resize_array(NULL, words, sizeof(uint64_t)); // image of a set
+    int i, j, b, k;
+
+    for (k = 0; k < state->n_perms; k++)
+    {
+        const uint64_t* table = state->tables + (size_t)k * state->table_size;
+
+        for (i = job->first; i < job->last; i++)
+        {
+            const uint64_t* set = state->sets + (size_t)i * words;
+            uint64_t* c = state->canon + (size_t)i * words;
+            uint64_t diff = 0;
+
+            memset(image, 0, words * sizeof(uint64_t));
+            for (b = 0; b < state->n_bytes; b++)
+            {
+                unsigned byte = (unsigned)(set[b / 8] >> (8 * (b % 8))) & 0xff;
+
+                if (byte != 0)
+                {
+                    const uint64_t* entry = table + ((size_t)b * 256 + byte) * words;
+
+                    for (j = 0; j < words; j++)
+                    {
+                        image[j] |= entry[j];
+                    }
+                }
+            }
+
+            if (memcmp(image, set, words * sizeof(uint64_t)) == 0)
+            {
+                job->stabilizer[i]++;
+            }
+
+            // two sets of the same size compare lexicographically as the smallest vertex in only one of them
+            for (j = 0; j < words && (diff = image[j] ^ c[j]) == 0; j++)
+            {
+            }
+            if (j < words && (image[j] & diff & -diff) != 0)
+            {
+                memcpy(c, image, words * sizeof(uint64_t));
+            }
+        }
+    }
+
+    free(image);
+    return NULL;
+}
+
+/*
+ * Counts the permutations mapping each dominating set of a job onto itself
+ * A permutation fixes a set if it maps every vertex of the set into the set, which is usually
+ * disproved by the first vertex tested.
+ */
+void* count_stabilizers(void* arg)
+{
+    struct orbit_job* job = arg;
+    struct input* in = job->in;
+    int size = in->set_size;
+    int n_sets = job->last - job->first;
+    int words = (in->n + WORD_BITS - 1) / WORD_BITS; // words in a bitset
+    uint64_t* sets = calloc((size_t)n_sets * words, sizeof(uint64_t)); // the job's sets as bitsets
+    const int* perm;
+    struct group_iter gi;
+    int i, j;
+
+    if (sets == NULL)
+    {
+        printf("Out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < n_sets; i++)
+    {
+        const int* set = in->min_dom_set + (size_t)(job->first + i) * (size + 1);
+
+        for (j = 1; j <= size; j++)
+        {
+            sets[(size_t)i * words + set[j] / WORD_BITS] |= 1ULL << (set[j] % WORD_BITS);
+        }
+        job->stabilizer[job->first + i] = 0;
+    }
+
+    group_iter_init(in, &gi);
+    while ((perm = group_next(in, &gi)) != NULL)
+    {
+        for (i = 0; i < n_sets; i++)
+        {
+            const int* set = in->min_dom_set + (size_t)(job->first + i) * (size + 1);
+            const uint64_t* bits = sets + (size_t)i * words;
+
+            for (j = 1; j <= size && (bits[perm[set[j]] / WORD_BITS] >> (perm[set[j]] % WORD_BITS) & 1); j++)
+            {
+            }
+            if (j > size)
+            {
+                job->stabilizer[job->first + i]++;
+            }
+        }
+    }
+    group_iter_free(in, &gi);
+
+    free(sets);
+    return NULL;
+}
+
+/*
+ * Compiles a permutation into byte tables: entry v of table b is the image of the vertices whose bits
+ * are set in value v of byte b of a bitset
+ */
+void compile_permutation(int n, const int perm[], uint64_t* table)
+{
+    int words = (n + WORD_BITS - 1) / WORD_BITS;
+    int n_bytes = (n + 7) / 8;
+    int b, v, j, u;
+
+    for (b = 0; b < n_bytes; b++)
+    {
+        uint64_t* row = table + (size_t)b * 256 * words;
+
+        memset(row, 0, words * sizeof(uint64_t));
+
+        // each value adds its lowest vertex to the entry of the value without it
+        for (v = 1; v < 256; v++)
+        {
+            uint64_t* entry = row + (size_t)v * words;
+
+            memcpy(entry, row + (size_t)(v & (v - 1)) * words, words * sizeof(uint64_t));
+            u = 8 * b + __builtin_ctz(v);
+            if (u < n)
+            {
+                j = perm[u];
+                entry[j / WORD_BITS] |= 1ULL << (j % WORD_BITS);
+            }
+        }
+    }
+}
+
+/*
+ * Lists the vertices of a bitset in increasing order; returns their number
+ */
+int bitset_to_vector(int words, const uint64_t bits[], int arr[])
+{
+    int count = 0, j;
+
+    for (j = 0; j < words; j++)
+    {
+        uint64_t w = bits[j];
+
+        while (w != 0)
+        {
+            arr[count++] = j * WORD_BITS + __builtin_ctzll(w);
+            w &= w - 1;
+        }
+    }
+    return count;
+}
+
+/*
+ * Hashes a sorted dominating set (FNV-1a over its vertices)
+ */
+uint64_t hash_set(int size, int arr[])
+{
+    uint64_t h = 14695981039346656037ULL;
+    int j;
+
+    for (j = 0; j < size; j++)
+    {
+        h = (h ^ (uint32_t)arr[j]) * 1099511628211ULL;
+    }
+    return h;
 }
 
 /*
  * Array printing utility
  */
-void print_vector(int size, int arr[])
+void print_vector(struct out_writer* out, int size, int arr[])
 {
 	int i;
 	for (i = 1; i < size; i++)
 	{
-		printf("%3d ", arr[i]);
+		out_int_width(out, arr[i], 3);
+		out_char(out, ' ');
 	}
-	printf("\n");
-}
\ No newline at end of file
+	out_char(out, '\n');
+}
@@ -6,41 +6,61 @@
  * Output: goes out to standard output
  * 		   If verbosity is set to 1, graph followed by a dominating set
  *         If verbosity is set to 0, graph number, number of vertices, dominating set order
+ * Options: --flush  flush the output after every graph, so results survive the program being killed
+ *                   by a CPU limit; otherwise output is buffered and written in large blocks
  */
 
 #include <stdio.h> 
 #include <stdlib.h>
+#include <string.h>
+#include "../common/adjacency.h"
+#include "../common/out_writer.h"
 
-// maximum number of vertices
-#define NMAX 2187
-// maximum degree
-#define DEG_MAX 16
 #define DEBUG 0
 
-int read_graph(int* n, int degree[NMAX], int G[NMAX][DEG_MAX]); 
-void print_graph(int n, int degree[NMAX], int G[NMAX][DEG_MAX]);
-void min_dom_set(int level, int n, int degree[NMAX], int G[NMAX][DEG_MAX], int* n_dominated, int num_dominated[NMAX],
-				 int num_choice[NMAX], int* size, int dom[NMAX], int* min_size, int min_dom[NMAX], int mdd);
-void print_vector(int size, int arr[]);
-void print_verbose_min_dom_set(int min_size, int n, int min_dom[]);
-void print_nonverbose_min_dom_set(int graph_num, int n, int min_size);
-int calculate_mdd(int n, int degree[NMAX], int dom_degree[NMAX], int max_dom_degree[NMAX], int G[NMAX][DEG_MAX], int num_dominated[NMAX]);
-
-int main(int argc, char *argv[])
+/*
+ * Solver context, allocated once and reused for every level of the search and every graph in the input
+ * Keeping the search state here instead of in main() and in the recursion keeps stack frames small
+ */
+struct mdd_solver
 {
 	int n; // number of vertices
-	int degree[NMAX]; // degrees of vertices
-	int G[NMAX][DEG_MAX]; // adjacency list
+	int delta; // maximum degree of a vertex
+	int* degree; // degrees of vertices
+	int** G; // adjacency list
 	int n_dominated; // number of dominated vertices
-	int num_dominated[NMAX]; // number of times a vertex is dominated
-	int num_choice[NMAX]; // number of times a vertex could be dominated if all white vertices were red
+	int* num_dominated; // number of times a vertex is dominated
+	int* num_choice; // number of times a vertex could be dominated if all white vertices were red
 	int size; // number of vertices added to dominating set
-	int dom[NMAX]; // vertices added to dominating set
+	int* dom; // vertices added to dominating set
 	int min_size; // minimum number of vertices in dominating set
-	int min_dom[NMAX]; // vertices added to minimum dominating set
+	int* min_dom; // vertices added to minimum dominating set
+	int* dom_degree; // how many undominated vertices a vertex can dominate
+	int* max_dom_degree; // largest number of undominated vertices a neighbour can dominate
+	int* mdd_count; // number of undominated vertices for each value of max_dom_degree, up to delta + 1
+	int n_cap; // vertices the arrays above have room for
+	int delta_cap; // maximum degree mdd_count has room for
+};
+
+void print_graph(struct out_writer* out, int n, int degree[], int* G[]);
+void min_dom_set(int level, struct mdd_solver* s);
+void print_vector(int size, int arr[]);
+void print_verbose_min_dom_set(struct out_writer* out, int min_size, int n, int min_dom[]);
+void print_nonverbose_min_dom_set(struct out_writer* out, int graph_num, int n, int min_size);
+void init_mdd(struct mdd_solver* s);
+void update_mdd(struct mdd_solver* s, int u, int change);
+int calculate_mdd(int mdd_count[], int max_d);
+void reserve_solver(struct mdd_solver* s);
+
+int main(int argc, char *argv[])
+{
+	static struct adjacency a; // adjacency lists of the current graph
+	struct mdd_solver* s; // search state shared by all graphs
 	int verbose; // user-specified verbosity level, 0 for terse, 1 for verbose
+	int flush = 0; // 1 to flush the output after every graph
+	static struct out_writer out; // buffered standard output
 	int graph_num = 0; // graph number
-	int mdd = 0; // mdd bound
+	int i;
     
 	// prints error message if incorrect usage
 	if (argc < 2)
@@ -51,165 +71,250 @@ int main(int argc, char *argv[])
 
     // reads in the user-specified verbosity level
 	verbose = atoi(argv[1]);
+
+	// reads in the options
+	for (i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--flush") == 0)
+		{
+			flush = 1;
+		}
+		else
+		{
+			printf("Unknown option %s\nOptions: --flush\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (out_open(&out, stdout, flush) != 0)
+	{
+		printf("Not enough memory for the output\n");
+		return EXIT_FAILURE;
+	}
+
+	s = calloc(1, sizeof(struct mdd_solver));
+	if (s == NULL)
+	{
+		printf("Not enough memory for the solver\n");
+		return EXIT_FAILURE;
+	}
 	
 	// processes input    
-    while (read_graph(&n, degree, G) == 0)
+    while (read_adjacency(&a) == 0)
     {
+		s->n = a.n;
+		s->degree = a.degree;
+		s->G = a.G;
+		reserve_solver(s);
+
 		// increments the number of graph
 		graph_num++;
 
         // if verbose output selected, print graph, find and print minimum dominating set
 		if (verbose == 1)
 		{
-			print_graph(n, degree, G);
-			min_dom_set(0, n, degree, G, &n_dominated, num_dominated, num_choice, &size, dom, &min_size, min_dom, mdd);
-			print_verbose_min_dom_set(min_size, n, min_dom);
+			print_graph(&out, s->n, s->degree, s->G);
+			min_dom_set(0, s);
+			print_verbose_min_dom_set(&out, s->min_size, s->n, s->min_dom);
 		}
 		// if terse output selected, print graph number and number of vertices, find and print minimum dominating set order
         else
         {
-			min_dom_set(0, n, degree, G, &n_dominated, num_dominated, num_choice, &size, dom, &min_size, min_dom, mdd);
-			print_nonverbose_min_dom_set(graph_num, n, min_size);
+			min_dom_set(0, s);
+			print_nonverbose_min_dom_set(&out, graph_num, s->n, s->min_size);
         }
+		out_flush(&out);
+		out_end_record(&out);
     }
+
+	free(s->num_dominated);
+	free(s->num_choice);
+	free(s->dom);
+	free(s->min_dom);
+	free(s->dom_degree);
+	free(s->max_dom_degree);
+	free(s->mdd_count);
+	free(s);
+	free_adjacency(&a);
+	out_close(&out);
 	
 	return EXIT_SUCCESS;
 }
 
 /*
- * Calcuates MDD bounding
+ * Makes room in the solver for the current graph and finds its maximum degree
+ * The arrays only grow, so graphs of similar size reuse them
  */
-int calculate_mdd(int n, int degree[NMAX], int dom_degree[NMAX], int max_dom_degree[NMAX], int G[NMAX][DEG_MAX], int num_dominated[NMAX])
+void reserve_solver(struct mdd_solver* s)
 {
-	int i, j, temp, mdd;
+	int i;
 
-	for (i = 0; i < n; i++)
+	s->delta = 0;
+	for (i = 0; i < s->n; i++)
 	{
-		dom_degree[i] = 0;
-        max_dom_degree[i] = 0;
-	}
-	
-    // populate dom_degree with number of undominated vertices in the
-    // closed neighbourhood of i
-    for (i = 0; i < n; i++) 
-    {
-        for (j = 0; j <= degree[i]; j++)
-        {
-            if (num_dominated[G[i][j]] == 0) 
-            {
-                dom_degree[i]++;
-            }
-        }
-    }
-    
-    // for each undominated vertex i, max_dom_degree[i]
-    // is equal to the maximum dom_degree of an undominated neighbour
-    for (i = 0; i < n; i++)
-    {
-		for (j = 0; j <= degree[i]; j++)
+		if (s->degree[i] > s->delta)
 		{
-			if (num_dominated[i] == 0)
-			{
-				if (num_dominated[G[i][j]] == 0)
-				{
-					if (dom_degree[G[i][j]] > max_dom_degree[i])
-					{
-						max_dom_degree[i] = dom_degree[G[i][j]]; // largest number of vertices a neighbour can dominate
-					}
-				}
-			}
+			s->delta = s->degree[i];
 		}
-    }
+	}
 
-    // bubble sort max_dom_degree in ascending order
-    for (i = 0; i < n - 1; i++)
-    {
-        for (j = 0 ; j < n - i - 1; j++)
-        {
-            if (max_dom_degree[j] > max_dom_degree[j + 1]) 
-            {
-                temp = max_dom_degree[j];
-                max_dom_degree[j] = max_dom_degree[j + 1];
-                max_dom_degree[j + 1] = temp;
-            }
-        }
-    }
+	if (s->n > s->n_cap)
+	{
+		s->num_dominated = resize_array(s->num_dominated, s->n, sizeof(int));
+		s->num_choice = resize_array(s->num_choice, s->n, sizeof(int));
+		s->dom = resize_array(s->dom, s->n, sizeof(int));
+		s->min_dom = resize_array(s->min_dom, s->n, sizeof(int));
+		s->dom_degree = resize_array(s->dom_degree, s->n, sizeof(int));
+		s->max_dom_degree = resize_array(s->max_dom_degree, s->n, sizeof(int));
+		s->n_cap = s->n;
+	}
+	if (s->delta > s->delta_cap || s->mdd_count == NULL)
+	{
+		s->mdd_count = resize_array(s->mdd_count, s->delta + 2, sizeof(int));
+		s->delta_cap = s->delta;
+	}
+}
 
-    i = 0;
-    mdd = 0;
+/*
+ * Sets up MDD bounding for a graph with no vertices dominated yet
+ */
+void init_mdd(struct mdd_solver* s)
+{
+	int i, j;
 
-    while (i < n)
-    {		
-        if (max_dom_degree[i] != 0) 
-		{
-        	i += max_dom_degree[i];
-        	mdd++;
-		}
-		else 
+	for (i = 0; i <= s->delta + 1; i++)
+	{
+		s->mdd_count[i] = 0;
+	}
+
+	// every vertex of a closed neighbourhood is undominated
+	for (i = 0; i < s->n; i++)
+	{
+		s->dom_degree[i] = s->degree[i] + 1;
+	}
+
+	for (i = 0; i < s->n; i++)
+	{
+		s->max_dom_degree[i] = 0;
+		for (j = 0; j <= s->degree[i]; j++)
 		{
-			i++;
+			if (s->dom_degree[s->G[i][j]] > s->max_dom_degree[i])
+			{
+				s->max_dom_degree[i] = s->dom_degree[s->G[i][j]];
+			}
 		}
-    }
-    return mdd;
+		s->mdd_count[s->max_dom_degree[i]]++;
+	}
 }
 
 /*
- * Reads in a graph from standard input
+ * Updates MDD bounding after vertex u has been coloured red (change = -1) or white again (change = 1)
+ * Only vertices within distance 2 of u change their dom_degree, and only vertices within distance 3
+ * of u can change their max_dom_degree
  */
-int read_graph(int* n, int degree[NMAX], int G[NMAX][DEG_MAX]) 
+void update_mdd(struct mdd_solver* s, int u, int change)
 {
-    // reads in input as long as end of file is not reached
-	if (fscanf(stdin, "%d", n) == 1)
-	{
-		int i, j;
+	int i, j, k, v, w, x, max;
+	// a vertex of N[u] changed state if u is its only red neighbour
+	int changed = change < 0 ? 1 : 0;
 
-		// for each vertex
-		for (i = 0; i < *n; i++)
+	// each vertex that changed state is in the closed neighbourhood of its neighbours
+	for (i = 0; i <= s->degree[u]; i++)
+	{
+		v = s->G[u][i];
+		if (s->num_dominated[v] == changed)
 		{
-			// read in its degree
-			if (scanf("%d", &degree[i]) != 1)
+			for (j = 0; j <= s->degree[v]; j++)
 			{
-				return EXIT_FAILURE;
+				s->dom_degree[s->G[v][j]] += change;
 			}
+		}
+	}
 
-			if (degree[i] >= DEG_MAX)
+	// recomputes max_dom_degree of every vertex next to a vertex whose dom_degree changed
+	// a vertex may be visited more than once, which is harmless as the recomputation is idempotent
+	for (i = 0; i <= s->degree[u]; i++)
+	{
+		v = s->G[u][i];
+		if (s->num_dominated[v] != changed)
+		{
+			continue;
+		}
+		for (j = 0; j <= s->degree[v]; j++)
+		{
+			w = s->G[v][j];
+			for (k = 0; k <= s->degree[w]; k++)
 			{
-				printf("A vertex degree cannot be equal to or greater than %d", DEG_MAX);
-				return EXIT_FAILURE;
-			}
+				x = s->G[w][k];
 
-			// for each degree
-			for (j = 0; j < degree[i]; j++)
-			{
-				// read in the vertex's neighbours
-				if (scanf("%d", &G[i][j]) != 1)
+				// dominated vertices do not contribute to the bound
+				max = 0;
+				if (s->num_dominated[x] == 0)
 				{
-					return EXIT_FAILURE;
+					int l;
+					for (l = 0; l <= s->degree[x]; l++)
+					{
+						if (s->dom_degree[s->G[x][l]] > max)
+						{
+							max = s->dom_degree[s->G[x][l]];
+						}
+					}
 				}
+				s->mdd_count[s->max_dom_degree[x]]--;
+				s->max_dom_degree[x] = max;
+				s->mdd_count[max]++;
 			}
 		}
-        return EXIT_SUCCESS;
 	}
-    return EXIT_FAILURE;
+}
+
+/*
+ * Calcuates MDD bounding
+ * Walks the undominated vertices in ascending order of max_dom_degree, one bucket at a time:
+ * each vertex added to the dominating set dominates at most max_dom_degree of them
+ */
+int calculate_mdd(int mdd_count[], int max_d)
+{
+	int d, count, jumps;
+	int mdd = 0;
+	int skip = 0; // vertices already covered by the last jump out of a previous bucket
+
+	for (d = 1; d <= max_d; d++)
+	{
+		count = mdd_count[d];
+		if (skip >= count)
+		{
+			skip -= count;
+			continue;
+		}
+		count -= skip;
+		jumps = (count + d - 1) / d;
+		mdd += jumps;
+		skip = jumps * d - count;
+	}
+	return mdd;
 }
 
 /*
  * Prints graph in verbose output mode
  */
-void print_graph(int n, int degree[NMAX], int G[NMAX][DEG_MAX])
+void print_graph(struct out_writer* out, int n, int degree[], int* G[])
 {
 	int i, j;
 	
-	printf("%d\n", n);
+	out_int(out, n);
+	out_char(out, '\n');
 
 	for (i = 0; i < n; i++)
 	{
-		printf("%d ", degree[i]);
+		out_int(out, degree[i]);
+		out_char(out, ' ');
 		for (j = 0; j < degree[i]; j++)
 		{			
-			printf("%d ", G[i][j]);
+			out_int(out, G[i][j]);
+			out_char(out, ' ');
 		}
-		printf("\n");
+		out_char(out, '\n');
 	}
 }
 
@@ -217,73 +322,73 @@ void print_graph(int n, int degree[NMAX], int G[NMAX][DEG_MAX])
  * Finds a minimum dominating set of a graph
  * Coluring: red = in dominating set, blue = excluded from dominating set, white = undecided
  */
-void min_dom_set(int level, int n, int degree[NMAX], int G[NMAX][DEG_MAX], int* n_dominated, int num_dominated[NMAX],
-				 int num_choice[NMAX], int* size, int dom[NMAX], int* min_size, int min_dom[NMAX], int mdd)
+void min_dom_set(int level, struct mdd_solver* s)
 {
 	int i;
-    int dom_degree[NMAX]; // how many vertices can be dominated
-    int max_dom_degree[NMAX]; // largest number of vertices a neighbour can dominate
+	int mdd; // mdd bound
 
 	// initialize data structures
 	// level is the vertex currently under consideration
 	if (level == 0)
 	{
-		*n_dominated = 0;		
-		*size = 0;
+		s->n_dominated = 0;		
+		s->size = 0;
 		// no values assigned to dom[]
-		*min_size = n;		
+		s->min_size = s->n;		
 		
-		for (i = 0; i < n; i++)
+		for (i = 0; i < s->n; i++)
 		{
-			num_choice[i] = degree[i] + 1;
-			num_dominated[i] = 0;
-			min_dom[i] = i;
+			s->num_choice[i] = s->degree[i] + 1;
+			s->num_dominated[i] = 0;
+			s->min_dom[i] = i;
 			// add vertex to list of own neighbours
-			G[i][degree[i]] = i;			
-		}		 
+			s->G[i][s->degree[i]] = i;			
+		}
+
+		init_mdd(s);
 	}
 
 	#if DEBUG
 	printf("\nLevel %3d: \n", level);
 	printf("Current dominating set:\n");
-	print_vector(*size, dom);
+	print_vector(s->size, s->dom);
 	printf("Minimum dominating set:\n");
-	print_vector(*min_size, min_dom);
-	printf("Number of vertices dominated: %3d\n", *n_dominated);
+	print_vector(s->min_size, s->min_dom);
+	printf("Number of vertices dominated: %3d\n", s->n_dominated);
 	printf("Number of choices per vertex:\n");
-	print_vector(n, num_choice);
+	print_vector(s->n, s->num_choice);
 	printf("Number of times dominated:\n");
-	print_vector(n, num_dominated);
-	printf("Size is: %d, min_size is: %d\n", *size, *min_size);
+	print_vector(s->n, s->num_dominated);
+	printf("Size is: %d, min_size is: %d\n", s->size, s->min_size);
 	#endif
 	
 	// backtrack
-	for (i = 0; i < n; i++)
+	for (i = 0; i < s->n; i++)
 	{
-		if (num_choice[i] == 0)
+		if (s->num_choice[i] == 0)
 		{
 			return;
 		}
 	}
 
-	int u = n - *n_dominated; // number of undominated vertices
+	int u = s->n - s->n_dominated; // number of undominated vertices
     
-	mdd = calculate_mdd(n, degree, dom_degree, max_dom_degree, G, num_dominated);
+	mdd = calculate_mdd(s->mdd_count, s->delta + 1);
     
-    if (*size + mdd >= *min_size)
+    if (s->size + mdd >= s->min_size)
 	{
 	 	return;
 	}
 
-	if (level == n || *n_dominated == n)
+	if (level == s->n || s->n_dominated == s->n)
 	{
-		if (*size < *min_size)
+		if (s->size < s->min_size)
 		{
-			for (i = 0; i < n; i++)
+			for (i = 0; i < s->n; i++)
 			{
-				min_dom[i] = dom[i];
+				s->min_dom[i] = s->dom[i];
 			}
-			*min_size = *size;
+			s->min_size = s->size;
 		}
 		return;
 	}
@@ -292,50 +397,52 @@ void min_dom_set(int level, int n, int degree[NMAX], int G[NMAX][DEG_MAX], int*
 	u = level;
 	
 	// try colouring a vertex blue
-	for (i = 0; i <= degree[u]; i++)
+	for (i = 0; i <= s->degree[u]; i++)
 	{
-		num_choice[G[u][i]]--;
+		s->num_choice[s->G[u][i]]--;
 	}
 
 	// recursive call
-	min_dom_set(level + 1, n, degree, G, n_dominated, num_dominated, num_choice, size, dom, min_size, min_dom, mdd);
+	min_dom_set(level + 1, s);
 
 	// undo colouring a vertex blue (colour it white)
-	for (i = 0; i <= degree[u]; i++)
+	for (i = 0; i <= s->degree[u]; i++)
 	{
-		num_choice[G[u][i]]++;
+		s->num_choice[s->G[u][i]]++;
 	}
 	
 	// try colouring a vertex red
-	dom[u] = 1;
-	(*size)++;
+	s->dom[u] = 1;
+	s->size++;
 
-	for (i = 0; i <= degree[u]; i++)
+	for (i = 0; i <= s->degree[u]; i++)
 	{
-		num_dominated[G[u][i]]++;
+		s->num_dominated[s->G[u][i]]++;
 		// increase number of dominated vertices
-		if (num_dominated[G[u][i]] == 1)
+		if (s->num_dominated[s->G[u][i]] == 1)
 		{
-			(*n_dominated)++;
+			s->n_dominated++;
 		}
 	}
+	update_mdd(s, u, -1);
 	
 	// recursive call
-	min_dom_set(level + 1, n, degree, G, n_dominated, num_dominated, num_choice, size, dom, min_size, min_dom, mdd);
+	min_dom_set(level + 1, s);
 
 	// undo colouring a vertex red (colour it white)
-	dom[u] = 0;
-	(*size)--;	
+	s->dom[u] = 0;
+	s->size--;	
 
-	for (i = 0; i <= degree[u]; i++)
+	for (i = 0; i <= s->degree[u]; i++)
 	{
-		num_dominated[G[u][i]]--;
+		s->num_dominated[s->G[u][i]]--;
 		// decrease number of dominated vertices
-		if (num_dominated[G[u][i]] == 0)
+		if (s->num_dominated[s->G[u][i]] == 0)
 		{
-			(*n_dominated)--;
+			s->n_dominated--;
 		}
 	}
+	update_mdd(s, u, 1);
 }
 
 /*
@@ -354,29 +461,32 @@ void print_vector(int size, int arr[])
 /*
  * Prints a minimum dominating set order followed by a minimum dominating set in verbose output mode
  */
-void print_verbose_min_dom_set(int min_size, int n, int min_dom[])
+void print_verbose_min_dom_set(struct out_writer* out, int min_size, int n, int min_dom[])
 {
-	printf("%d\n", min_size);
+	out_int(out, min_size);
+	out_char(out, '\n');
 
     int i;
     for (i = 0; i < n; i++) 
 	{
         if (min_dom[i] == 1) 
 		{
-            printf("%d ", i);
+            out_int(out, i);
+            out_char(out, ' ');
         }
     }
-    printf("\n\n");
-
-	fflush(stdout);
+    out_str(out, "\n\n");
 }
 
 /*
  * Prints graph number, number of vertices, and a minimum dominating set order in terse output mode
  */
-void print_nonverbose_min_dom_set(int graph_num, int n, int min_size)
+void print_nonverbose_min_dom_set(struct out_writer* out, int graph_num, int n, int min_size)
 {
-	printf("%5d %3d %3d\n", graph_num, n, min_size);
-	
-	fflush(stdout);
+	out_int_width(out, graph_num, 5);
+	out_char(out, ' ');
+	out_int_width(out, n, 3);
+	out_char(out, ' ');
+	out_int_width(out, min_size, 3);
+	out_char(out, '\n');
 }
\ No newline at end of file
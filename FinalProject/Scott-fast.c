@@ -0,0 +1,3091 @@
+/*
+ * This program finds a minimum dominating set of a graph using bitset-based domination bookkeeping.
+ * It does not check the input graph for correctness.
+ * Input: provided through standard input
+ * 		  Format: number of vertices, degree of each vertex followed by a list of its neighbours
+ * Output: goes out to standard output
+ * 		   If verbosity is set to 1, graph followed by a dominating set
+ *         If verbosity is set to 0, graph number, number of vertices, dominating set order
+ * Options: --threads k  search each graph with k worker threads (default 1)
+ *          --batch k    search k graphs at a time, output stays in input order
+ *          --branching static|dynamic
+ *                       branch on vertices 0, 1, 2, ... in order (default), or on the undominated
+ *                       vertex with the fewest choices left
+ *          --no-warm-start  start the exact search from the whole vertex set
+ *          --no-reduce  search without applying the reduction rules first
+ *          --symmetry  find the automorphisms of each graph and search only one of each set of
+ *                       symmetric dominating sets
+ *          --group file  read the automorphisms of each graph from file instead, in input order:
+ *                       n, the number of automorphisms k, then k permutations of 0..n-1
+ *          --time-limit t  stop searching a graph after t seconds
+ *          --node-limit k  stop searching a graph after about k search nodes
+ *                       with either limit, each terse output line also gives a lower bound on the
+ *                       dominating set order and whether the order printed is proven optimal
+ *          --graphs k  search only graph k, counting from 1
+ *          --graphs a-b  search only graphs a to b; "a-" runs to the end of the input
+ *                       graphs keep their numbers in the output, so the outputs of several ranges
+ *                       concatenate to the output of the whole input
+ *          --flush  flush the output after every graph, so results survive the program being killed
+ *                       by a CPU limit; otherwise output is buffered and written in large blocks
+ * Graphs of any order and degree are accepted: the graph and the search state are sized at run time,
+ * in O(n + m) memory, and grow only when a graph larger than all before it is read.
+ * Input may also be a binary graph file written by graph_convert.c. It is memory-mapped, or read
+ * into memory when it comes through a pipe, and --graphs jumps straight to the first graph asked
+ * for through the file's index.
+ * Compile: gcc -O2 -pthread Scott-fast.c
+ *
+ * The search is the same red/blue backtrack as Scott-original.c, but the set of dominated vertices
+ * is kept as a packed bitset. Each closed neighbourhood N[v] is stored as the few 64-bit words of
+ * that bitset it touches, so colouring a vertex red is a handful of word operations and the number
+ * of dominated vertices is maintained with popcount. Vertices that can no longer be dominated are
+ * counted as they appear, so every search node costs O(deg(u)) instead of a rescan of all n vertices.
+ * The search runs as a loop over an explicit trail of decisions rather than recursing once per
+ * vertex, so its depth is not limited by the size of the stack.
+ *
+ * Dynamic branching picks the undominated vertex v with the fewest white vertices left in N[v], and
+ * branches over which of them becomes red: the first is coloured red, or blue and then the next one
+ * is tried. Undominated vertices are kept in a bucket queue keyed by choice count, so that the vertex
+ * is found without scanning the graph.
+ *
+ * Regular graphs of degree 3, 4, 6 or 8 are searched by a copy of the search compiled for that
+ * degree: the neighbourhood loops are fully unrolled, rows are found by a fixed stride instead of a
+ * pointer, and the degree bound divides by a constant. Other graphs use the generic copy.
+ *
+ * Before the search, reduction rules colour vertices that some minimum dominating set must or need
+ * not contain, until none applies: a vertex with one choice left forces it red (so a leaf forces its
+ * support), a vertex whose undominated neighbourhood lies within that of another white vertex turns
+ * blue, and a vertex with the choices of another undominated vertex among its own is ignored, as it
+ * is dominated whenever that vertex is. The search starts from these colours and never branches on
+ * them, so on sparse graphs it only sees what the rules leave.
+ *
+ * With automorphisms, only dominating sets that are lexicographically largest among their images
+ * under every generator are searched for, and vertex 0 is coloured red at the root when its orbit
+ * contains a closed neighbourhood, since then every dominating set has an image containing it.
+ *
+ * A disconnected graph is split into its connected components, which are searched one after another
+ * by all the workers and whose minimums are added up.
+ *
+ * Before the exact search, a greedy dominating set improved by local search becomes the first
+ * minimum, so the bounds can prune from the start. If it already meets the larger of the degree
+ * and MDD lower bounds at the root, it is optimal and the exact search is skipped.
+ *
+ * With more than one thread, the red subtrees of the first few levels are handed out as tasks.
+ * Every worker owns a deque of tasks: it takes its own newest task first and steals the oldest
+ * (largest) task of another worker when it runs out, and sleeps while no task is queued anywhere.
+ * All workers prune against one shared minimum.
+ *
+ * In batch mode a reader thread parses graphs ahead into a ring of slots, k solver threads each take
+ * the next unsolved graph, and the main thread prints the results in the order the graphs were read.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <fcntl.h>
+#include "../common/int_reader.h"
+#include "../common/graph_file.h"
+#include "../common/automorphism.h"
+#include "../common/out_writer.h"
+
+// deepest level at which the search tree is split into tasks
+#define SPLIT_MAX 24
+// maximum number of worker threads
+#define THREAD_MAX 256
+// slots per solver thread in batch mode, so the reader can stay ahead of the solvers
+#define SLOTS_PER_SOLVER 2
+// search nodes between two checks of the time and node limits
+#define CHECK_INTERVAL 1024
+// work allowed for finding the automorphisms of a graph, in vertex visits
+#define SYMMETRY_BUDGET 100000000LL
+#define DEBUG 0
+
+// degree of the closed neighbourhood rows of vertex u in a search kernel for D-regular graphs,
+// D = 0 for the kernel that works on any graph
+#define KERNEL_DEGREE(g, u, D) ((D) > 0 ? (D) : (g)->degree[u])
+// rows of a D-regular graph are D + 1 entries apart, so their start is computed instead of loaded
+#define KERNEL_ROW(g, rows, all, u, D) ((D) > 0 ? (g)->all + (size_t)(u) * ((D) + 1) : (g)->rows[u])
+
+/*
+ * Input graph together with its closed neighbourhoods in packed form
+ */
+struct graph
+{
+	int num; // graph number, counting from 1 in input order
+	int n; // number of vertices
+	int delta; // maximum degree of a vertex
+	int regular; // degree of every vertex if all degrees are equal, -1 otherwise
+	int* degree; // degrees of vertices
+	int** G; // closed adjacency list, the neighbours of i followed by G[i][degree[i]] = i
+	int* nb_count; // number of bitset words touched by N[i]
+	int** nb_word; // indices of bitset words touched by N[i]
+	uint64_t** nb_mask; // bits of N[i] within each of those words
+	int* adj; // the rows of G back to back, degree[i] + 1 entries for vertex i, in adj_buf or a mapped file
+	int* nb_word_all; // the rows of nb_word, laid out like adj
+	uint64_t* nb_mask_all; // the rows of nb_mask, laid out like adj
+	int n_cap; // vertices the arrays have room for
+	int adj_cap; // entries nb_word_all and nb_mask_all have room for
+	int* adj_buf; // adj when the rows are not mapped
+	int adj_buf_cap; // entries adj_buf has room for
+	int n_gens; // number of automorphisms given with the graph
+	int* gens; // automorphism k maps vertex i to gens[k * n + i]
+	size_t gens_cap; // entries gens has room for
+};
+
+/*
+ * Smallest dominating set found so far, shared by all workers
+ */
+struct incumbent
+{
+	atomic_int size; // minimum number of vertices in dominating set
+	pthread_mutex_t lock; // guards dom
+	int* dom; // vertices added to minimum dominating set
+};
+
+/*
+ * Subtree of the search: the colours chosen on the way from the root, 1 for red and 0 for blue
+ * With static branching the vertices are 0..n_decisions-1
+ */
+struct task
+{
+	int n_decisions;
+	int vertex[SPLIT_MAX];
+	char red[SPLIT_MAX];
+};
+
+/*
+ * User-specified options
+ */
+struct options
+{
+	int verbose; // 0 for terse, 1 for verbose
+	int n_workers; // threads used to search each graph
+	int n_solvers; // graphs searched at a time, 0 outside batch mode
+	int dynamic; // 1 to branch on the undominated vertex with the fewest choices
+	int warm_start; // 1 to start from a greedy dominating set improved by local search
+	int reduce; // 1 to apply the reduction rules before the search
+	int symmetry; // 1 to find the automorphisms of graphs that come without them
+	double time_limit; // seconds allowed per graph, 0 for no limit
+	long long node_limit; // search nodes allowed per graph, 0 for no limit
+	int flush; // 1 to flush the output after every graph
+	struct out_writer* out; // buffered standard output the results are written to
+};
+
+/*
+ * Where graphs are read from: standard input as text, or a mapped binary graph file
+ */
+struct source
+{
+	int binary; // 1 if the input is a binary graph file
+	struct graph_file file; // the mapped file when binary
+	int first; // number of the first graph to search
+	int last; // number of the last graph to search, 0 to run to the end
+	int graph_num; // number of the last graph read or skipped
+	int has_group; // 1 if automorphisms are read for every graph
+	struct int_reader group; // reader of the automorphisms
+};
+
+/*
+ * Tasks owned by one worker
+ * The owner pushes and pops at the tail, thieves take from the head
+ */
+struct deque
+{
+	pthread_mutex_t lock;
+	struct task* tasks;
+	int head;
+	int tail;
+	int capacity;
+};
+
+/*
+ * Scratch space for the greedy dominating set and its local search
+ */
+struct heuristic
+{
+	int* in_set; // 1 for vertices in the dominating set
+	int size; // number of vertices in the dominating set
+	int* count; // number of vertices of the dominating set in N[i]
+	int* cov; // number of undominated vertices in N[i], while the greedy set is built
+	int* head; // first vertex of each bucket of the greedy queue, delta + 2 buckets
+	int* next; // next vertex in the same bucket of the greedy queue
+	int* mdd_count; // vertices for each value of max_dom_degree at the root, delta + 2 values
+};
+
+struct search;
+
+/*
+ * Colours forced by the reduction rules, and the scratch space used to find them
+ * A vertex is live while it is neither dominated by a forced red vertex nor ignored
+ */
+struct reduction
+{
+	char* fixed; // FIXED_WHITE, FIXED_RED or FIXED_BLUE for each vertex
+	char* covered; // 1 for vertices dominated by a forced red vertex
+	char* ignored; // 1 for vertices dominated by any red vertex that dominates some live vertex
+	int* n_cand; // number of vertices of N[i] not coloured blue
+	int* queue; // vertices whose rules have to be checked again, a ring of n entries
+	char* queued; // 1 for vertices in the queue
+	int head; // first vertex of the queue
+	int length; // number of vertices in the queue
+	int* mark; // stamp of the vertices in the set being compared
+	int* seen; // stamp of the vertices already compared against
+	int stamp; // current stamp
+	int n_red; // number of vertices forced red
+	int n_blue; // number of vertices forced blue
+	int n_ignored; // number of vertices ignored
+};
+
+#define FIXED_WHITE 0
+#define FIXED_RED 1
+#define FIXED_BLUE 2
+
+/*
+ * Connected components of a graph, and the component being searched
+ */
+struct components
+{
+	int n_components; // number of components
+	int* comp; // component of each vertex
+	int* start; // first entry of each component in order, n_components + 1 entries
+	int* order; // vertices grouped by component, in increasing order within each
+	int* local; // number of each vertex within its component
+	int* dom; // minimum dominating set of the whole graph, put together component by component
+	struct graph part; // the component being searched, its vertices numbered by local
+};
+
+/*
+ * Automorphisms used to break the symmetry of the search
+ * Only dominating sets that are lexicographically largest among their images under every generator
+ * are searched for, with red before blue and vertices in increasing order
+ */
+struct symmetry
+{
+	int n_gens; // number of generators, 0 if symmetry is not broken
+	const int* gens; // generator k maps vertex i to gens[k * n + i]
+	int* moved; // vertices each generator moves, in increasing order, back to back
+	int* moved_start; // first entry of each generator in moved, n_gens + 1 entries
+	size_t moved_cap; // entries moved has room for
+	int start_cap; // entries moved_start has room for
+	struct automorphisms aut; // automorphisms found by search
+};
+
+/*
+ * Everything the workers searching one graph share
+ */
+struct pool
+{
+	struct graph* g;
+	struct incumbent best;
+	struct options* opt;
+	int n_workers;
+	int split_level; // second branches of decisions above this depth become tasks
+	atomic_int pending; // tasks queued or being searched
+	atomic_int queued; // tasks waiting in the deques
+	pthread_mutex_t idle_lock; // guards waiting on idle
+	pthread_cond_t idle; // signalled when a task is pushed or the search ends
+	atomic_int stop; // set once a time or node limit is reached
+	atomic_llong nodes; // search nodes visited by all workers, counted CHECK_INTERVAL at a time
+	struct timespec start; // when the search of the current graph started
+	int lower; // lower bound on the dominating set order
+	int proven; // 1 if the search finished, so the minimum is optimal
+	struct heuristic warm; // scratch space for the warm start
+	struct reduction reduce; // colours forced before the search
+	struct components parts; // components searched one at a time
+	struct symmetry sym; // automorphisms of the graph being searched
+	int n_cap; // vertices the state of the pool and its workers has room for
+	int adj_cap; // closed adjacency entries the undo stacks of the workers have room for
+	int delta_cap; // maximum degree the buckets have room for
+	void (*search)(int level, struct graph* g, struct search* s); // search kernel for the graph
+	struct deque deques[THREAD_MAX];
+};
+
+/*
+ * A vertex coloured by the search, in the order the colours were chosen
+ * Static branching tries blue first, dynamic branching tries red first, then the other colour
+ */
+struct decision
+{
+	int vertex;
+	int red; // current colour, 1 for red and 0 for blue
+	int second; // 1 once the vertex has been recoloured with its second colour
+	int anchor; // vertex whose closed neighbourhood is being branched over, -1 for static branching
+};
+
+/*
+ * State of the red/blue search, one per worker
+ * Colouring: red = in dominating set, blue = excluded from dominating set, white = undecided
+ */
+struct search
+{
+	uint64_t* dominated; // bitset of dominated vertices
+	int n_dominated; // number of dominated vertices
+	int* num_choice; // number of times a vertex could be dominated if all white vertices were red
+	int n_dead; // number of vertices with no choices left, kept up to date by the colouring loops
+	int size; // number of vertices added to dominating set
+	int* dom; // vertices added to dominating set
+	int* blue; // vertices excluded from dominating set
+	int* choice_head; // first undominated vertex with each number of choices, delta + 2 buckets
+	int* choice_next; // next undominated vertex with the same number of choices
+	int* choice_prev; // previous undominated vertex with the same number of choices
+	int max_choice; // largest number of choices a vertex can have, delta + 1
+	struct decision* trail; // decisions from the root of the current task to the current node
+	uint64_t* undo; // bitset words overwritten by the red decisions on the trail
+	int undo_top; // number of words in use in undo
+	struct task task; // colours that lead to the root of the current task
+	int dynamic; // 1 if the choice buckets are kept up to date
+	int nodes; // search nodes visited since the limits were last checked
+	struct pool* pool; // shared minimum and task deques
+	int id; // worker number, also the index of its deque
+	pthread_t thread;
+};
+
+/*
+ * A graph in batch mode, from being read until its result is printed
+ */
+struct slot
+{
+	struct graph* g;
+	int state; // SLOT_EMPTY, SLOT_READ or SLOT_SOLVED
+	int min_size; // minimum number of vertices in dominating set
+	int* min_dom; // vertices added to minimum dominating set
+	int n_cap; // vertices min_dom has room for
+	int lower; // lower bound on the dominating set order
+	int proven; // 1 if min_size is optimal
+};
+
+#define SLOT_EMPTY 0
+#define SLOT_READ 1
+#define SLOT_SOLVED 2
+
+/*
+ * Ring of slots shared by the reader, the solvers and the printer in batch mode
+ * Graph number i (counting from 0) always goes through slot i % n_slots
+ */
+struct batch
+{
+	pthread_mutex_t lock; // guards everything below and the slot states
+	pthread_cond_t changed; // signalled whenever a slot changes state
+	struct slot* slots;
+	int n_slots;
+	int n_read; // graphs read so far
+	int n_taken; // graphs handed to solvers so far
+	int n_printed; // graphs printed so far
+	int eof; // no more graphs will be read
+	struct options* opt;
+	struct source* src;
+};
+
+int read_graph(struct graph* g, struct source* src);
+int parse_graph(struct graph* g);
+int load_graph(struct graph* g, struct source* src);
+int parse_range(const char* arg, struct source* src);
+int read_group(struct graph* g, struct source* src, int n);
+void* resize_array(void* arr, size_t count, size_t size);
+void reserve_graph(struct graph* g, int n, int n_adj, int own_rows);
+void link_rows(struct graph* g);
+void free_graph(struct graph* g);
+void reserve_pool(struct pool* p, struct search* workers[], struct graph* g);
+void print_graph(struct out_writer* out, struct graph* g);
+void build_neighbourhoods(struct graph* g);
+void init_search(struct graph* g, struct search* s);
+void insert_choice(struct search* s, int v, int c);
+void remove_choice(struct search* s, int v, int c);
+int select_vertex(struct search* s);
+void colour_blue(struct graph* g, struct search* s, int u);
+void uncolour_blue(struct graph* g, struct search* s, int u);
+void colour_red(struct graph* g, struct search* s, int u, uint64_t saved[]);
+void uncolour_red(struct graph* g, struct search* s, int u, uint64_t saved[]);
+void record_dom_set(struct graph* g, struct search* s);
+int check_limits(struct search* s);
+int root_lower_bound(struct graph* g, struct heuristic* h);
+int in_closed_neighbourhood(struct graph* g, int u, int x);
+void add_to_set(struct graph* g, struct heuristic* h, int v);
+void remove_from_set(struct graph* g, struct heuristic* h, int v);
+int is_redundant(struct graph* g, struct heuristic* h, int v);
+void greedy_dom_set(struct graph* g, struct heuristic* h);
+int swap_dom_set(struct graph* g, struct heuristic* h, int v);
+void improve_dom_set(struct graph* g, struct heuristic* h);
+void reduce_graph(struct graph* g, struct reduction* r, int apply);
+void reduce_vertex(struct graph* g, struct reduction* r, int v);
+void force_red(struct graph* g, struct reduction* r, int u);
+void force_blue(struct graph* g, struct reduction* r, int u);
+void ignore_vertex(struct graph* g, struct reduction* r, int x);
+void enqueue_vertex(struct graph* g, struct reduction* r, int v);
+void break_symmetry(struct graph* g, struct pool* p);
+int lex_smaller(struct graph* g, struct search* s, struct symmetry* sym);
+void apply_reduction(struct graph* g, struct search* s, struct reduction* r);
+void min_dom_set(int level, struct graph* g, struct search* s);
+void min_dom_set_3(int level, struct graph* g, struct search* s);
+void min_dom_set_4(int level, struct graph* g, struct search* s);
+void min_dom_set_6(int level, struct graph* g, struct search* s);
+void min_dom_set_8(int level, struct graph* g, struct search* s);
+void select_search(struct pool* p, struct graph* g);
+void push_task(struct pool* p, int id, struct task* t);
+void wake_workers(struct pool* p, int all);
+int pop_task(struct pool* p, int id, struct task* t);
+void* worker(void* arg);
+void solve(struct graph* g, struct pool* p, struct search* workers[]);
+void solve_component(struct graph* g, struct pool* p, struct search* workers[]);
+void find_components(struct graph* g, struct components* c);
+void extract_component(struct graph* g, struct components* c, int k);
+int init_pool(struct pool* p, struct search* workers[], struct options* opt);
+void free_pool(struct pool* p, struct search* workers[]);
+void* batch_reader(void* arg);
+void* batch_solver(void* arg);
+int run_batch(struct options* opt, struct source* src);
+void print_result(struct options* opt, int graph_num, struct graph* g, int min_size, int min_dom[], int lower, int proven);
+void print_vector(int size, int arr[]);
+void print_verbose_min_dom_set(struct out_writer* out, int min_size, int n, int min_dom[]);
+void print_nonverbose_min_dom_set(struct out_writer* out, int graph_num, int n, int min_size);
+void print_anytime_min_dom_set(struct out_writer* out, int graph_num, int n, int min_size, int lower, int proven);
+
+int main(int argc, char *argv[])
+{
+	static struct graph g; // current graph
+	static struct pool p; // shared state of the workers
+	struct search* workers[THREAD_MAX]; // search state of each worker
+	struct options opt = { 0, 1, 0, 0, 1, 1, 0, 0, 0, 0, NULL }; // user-specified options
+	static struct out_writer out; // buffered standard output
+	static struct source src = { 0 }; // input graphs
+	int i, status = EXIT_SUCCESS;
+
+	// prints error message if incorrect usage
+	if (argc < 2)
+	{
+		printf("Must specify verbosity level (0 for terse, 1 for verbose)\nExample: a.out 0 < in.txt > out.txt\n");
+		return EXIT_FAILURE;
+	}
+
+	// reads in the user-specified verbosity level
+	opt.verbose = atoi(argv[1]);
+
+	// reads in the options
+	for (i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			opt.n_workers = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc)
+		{
+			opt.n_solvers = atoi(argv[++i]);
+			if (opt.n_solvers < 1 || opt.n_solvers > THREAD_MAX)
+			{
+				printf("The number of graphs searched at a time must be between 1 and %d\n", THREAD_MAX);
+				return EXIT_FAILURE;
+			}
+		}
+		else if (strcmp(argv[i], "--branching") == 0 && i + 1 < argc && strcmp(argv[i + 1], "static") == 0)
+		{
+			opt.dynamic = 0;
+			i++;
+		}
+		else if (strcmp(argv[i], "--branching") == 0 && i + 1 < argc && strcmp(argv[i + 1], "dynamic") == 0)
+		{
+			opt.dynamic = 1;
+			i++;
+		}
+		else if (strcmp(argv[i], "--no-warm-start") == 0)
+		{
+			opt.warm_start = 0;
+		}
+		else if (strcmp(argv[i], "--no-reduce") == 0)
+		{
+			opt.reduce = 0;
+		}
+		else if (strcmp(argv[i], "--symmetry") == 0)
+		{
+			opt.symmetry = 1;
+		}
+		else if (strcmp(argv[i], "--group") == 0 && i + 1 < argc)
+		{
+			int fd = open(argv[++i], O_RDONLY);
+
+			if (fd < 0 || int_reader_open(&src.group, fd) != 0)
+			{
+				printf("Cannot read automorphisms from %s\n", argv[i]);
+				return EXIT_FAILURE;
+			}
+			src.has_group = 1;
+		}
+		else if (strcmp(argv[i], "--time-limit") == 0 && i + 1 < argc)
+		{
+			opt.time_limit = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--node-limit") == 0 && i + 1 < argc)
+		{
+			opt.node_limit = atoll(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--flush") == 0)
+		{
+			opt.flush = 1;
+		}
+		else if (strcmp(argv[i], "--graphs") == 0 && i + 1 < argc)
+		{
+			if (parse_range(argv[++i], &src) != 0)
+			{
+				printf("Graph range must be k, a-b or a-, counting from 1\n");
+				return EXIT_FAILURE;
+			}
+		}
+		else
+		{
+			printf("Unknown option %s\nOptions: --threads k, --batch k, --branching static|dynamic, "
+				   "--no-warm-start, --no-reduce, --symmetry, --group file, --time-limit t, --node-limit k, --graphs a-b, "
+				   "--flush\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	// reads a binary graph file in place, or into memory if it comes through a pipe; anything else
+	// is parsed as text
+	status = graph_file_open(&src.file, STDIN_FILENO);
+	if (status == 1)
+	{
+		const char* head;
+
+		if (int_reader_open(&int_reader_stdin, STDIN_FILENO) != 0)
+		{
+			printf("Not enough memory for the input\n");
+			return EXIT_FAILURE;
+		}
+		head = int_reader_peek(&int_reader_stdin, 8);
+		if (head != NULL && memcmp(head, GRAPH_FILE_MAGIC, 8) == 0)
+		{
+			status = graph_file_read(&src.file, STDIN_FILENO, head, int_reader_stdin.len - int_reader_stdin.pos);
+			int_reader_close(&int_reader_stdin);
+		}
+	}
+	switch (status)
+	{
+	case 0:
+		src.binary = 1;
+		break;
+	case -1:
+		printf("Damaged binary graph file\n");
+		return EXIT_FAILURE;
+	}
+	status = EXIT_SUCCESS;
+
+	if (opt.n_workers < 1 || opt.n_workers > THREAD_MAX)
+	{
+		printf("The number of threads must be between 1 and %d\n", THREAD_MAX);
+		return EXIT_FAILURE;
+	}
+
+	if (out_open(&out, stdout, opt.flush) != 0)
+	{
+		printf("Not enough memory for the output\n");
+		return EXIT_FAILURE;
+	}
+	opt.out = &out;
+
+	if (opt.n_solvers > 0)
+	{
+		status = run_batch(&opt, &src);
+	}
+	else
+	{
+		// worker state and deques are allocated once and reused for every graph
+		if (init_pool(&p, workers, &opt) != 0)
+		{
+			printf("Not enough memory for the workers\n");
+			return EXIT_FAILURE;
+		}
+
+		// processes input
+		while (read_graph(&g, &src) == 0)
+		{
+			build_neighbourhoods(&g);
+			solve(&g, &p, workers);
+			print_result(&opt, g.num, &g, p.best.size, p.best.dom, p.lower, p.proven);
+		}
+
+		free_pool(&p, workers);
+		free_graph(&g);
+	}
+
+	out_close(&out);
+	graph_file_close(&src.file);
+	if (src.has_group)
+	{
+		close(src.group.fd);
+		int_reader_close(&src.group);
+	}
+
+	return status;
+}
+
+/*
+ * Prints the result for one graph
+ */
+void print_result(struct options* opt, int graph_num, struct graph* g, int min_size, int min_dom[], int lower, int proven)
+{
+	int anytime = opt->time_limit > 0 || opt->node_limit > 0;
+
+	// if verbose output selected, print graph and minimum dominating set
+	if (opt->verbose == 1)
+	{
+		print_graph(opt->out, g);
+		if (anytime)
+		{
+			out_str(opt->out, "Lower bound ");
+			out_int(opt->out, lower);
+			out_str(opt->out, proven ? ", optimal\n" : ", not proven\n");
+		}
+		print_verbose_min_dom_set(opt->out, min_size, g->n, min_dom);
+	}
+	// if terse output selected, print graph number and number of vertices, and minimum dominating set order
+	else if (anytime)
+	{
+		print_anytime_min_dom_set(opt->out, graph_num, g->n, min_size, lower, proven);
+	}
+	else
+	{
+		print_nonverbose_min_dom_set(opt->out, graph_num, g->n, min_size);
+	}
+
+	// the result goes to the stream's buffer, in order with anything printed directly
+	out_flush(opt->out);
+	out_end_record(opt->out);
+}
+
+/*
+ * Reads "k", "a-b" or "a-" into the range of graphs to search; returns 0 on success
+ */
+int parse_range(const char* arg, struct source* src)
+{
+	char* end;
+	long first, last;
+
+	first = strtol(arg, &end, 10);
+	if (end == arg || first < 1 || first > INT32_MAX)
+	{
+		return 1;
+	}
+	if (*end == '\0')
+	{
+		last = first;
+	}
+	else if (*end == '-' && end[1] == '\0')
+	{
+		last = 0;
+	}
+	else if (*end == '-')
+	{
+		arg = end + 1;
+		last = strtol(arg, &end, 10);
+		if (end == arg || *end != '\0' || last < first || last > INT32_MAX)
+		{
+			return 1;
+		}
+	}
+	else
+	{
+		return 1;
+	}
+
+	src->first = (int)first;
+	src->last = (int)last;
+	return 0;
+}
+
+/*
+ * Reads in the next graph in the range asked for and numbers it
+ */
+int read_graph(struct graph* g, struct source* src)
+{
+	if (src->last > 0 && src->graph_num >= src->last)
+	{
+		return EXIT_FAILURE;
+	}
+
+	if (src->binary)
+	{
+		// the index gives the offset of any graph, so the graphs before the range are never read,
+		// though their automorphisms still have to be
+		while (src->graph_num < src->first - 1)
+		{
+			if (src->has_group && read_group(g, src, -1) != 0)
+			{
+				return EXIT_FAILURE;
+			}
+			src->graph_num++;
+		}
+		if (load_graph(g, src) != 0)
+		{
+			return EXIT_FAILURE;
+		}
+	}
+	else
+	{
+		// text has to be parsed to find where a graph starts
+		while (src->graph_num < src->first - 1)
+		{
+			if (parse_graph(g) != 0 || (src->has_group && read_group(g, src, g->n) != 0))
+			{
+				return EXIT_FAILURE;
+			}
+			src->graph_num++;
+		}
+		if (parse_graph(g) != 0)
+		{
+			return EXIT_FAILURE;
+		}
+	}
+
+	g->n_gens = 0;
+	if (src->has_group && read_group(g, src, g->n) != 0)
+	{
+		return EXIT_FAILURE;
+	}
+
+	g->num = ++src->graph_num;
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Reads the automorphisms of graph src->graph_num + 1: the number of vertices, the number of
+ * automorphisms, then each automorphism as the images of vertices 0 to n - 1
+ * With n = -1 the automorphisms of a graph that is skipped are read and thrown away.
+ * Returns EXIT_FAILURE, with a message, unless the automorphisms are permutations that map every
+ * edge of the graph onto an edge.
+ */
+int read_group(struct graph* g, struct source* src, int n)
+{
+	int m, k, i, j, x;
+	int* seen;
+
+	if (int_reader_next(&src->group, &m) != 1 || int_reader_next(&src->group, &k) != 1 || m < 1 || k < 0
+		|| (n >= 0 && m != n))
+	{
+		printf("No automorphisms of graph %d with %d vertices\n", src->graph_num + 1, n);
+		return EXIT_FAILURE;
+	}
+
+	if (n < 0)
+	{
+		for (i = 0; i < k; i++)
+		{
+			for (j = 0; j < m; j++)
+			{
+				if (int_reader_next(&src->group, &x) != 1)
+				{
+					printf("No automorphisms of graph %d\n", src->graph_num + 1);
+					return EXIT_FAILURE;
+				}
+			}
+		}
+		return EXIT_SUCCESS;
+	}
+
+	if ((size_t)k * n > g->gens_cap)
+	{
+		g->gens_cap = (size_t)k * n;
+		g->gens = resize_array(g->gens, g->gens_cap, sizeof(int));
+	}
+	seen = calloc(n, sizeof(int));
+	if (seen == NULL)
+	{
+		printf("Not enough memory for the graph\n");
+		return EXIT_FAILURE;
+	}
+
+	for (g->n_gens = 0; g->n_gens < k; g->n_gens++)
+	{
+		int* perm = g->gens + (size_t)g->n_gens * n;
+
+		for (i = 0; i < n; i++)
+		{
+			if (int_reader_next(&src->group, &perm[i]) != 1 || perm[i] < 0 || perm[i] >= n
+				|| seen[perm[i]] == g->n_gens + 1)
+			{
+				printf("Automorphism %d of graph %d is not a permutation\n", g->n_gens + 1, src->graph_num + 1);
+				free(seen);
+				return EXIT_FAILURE;
+			}
+			seen[perm[i]] = g->n_gens + 1;
+		}
+
+		// every edge {i, G[i][j]} has to map onto an edge
+		for (i = 0; i < n; i++)
+		{
+			if (g->degree[perm[i]] != g->degree[i])
+			{
+				break;
+			}
+			for (j = 0; j < g->degree[perm[i]]; j++)
+			{
+				seen[g->G[perm[i]][j]] = -(i + 1);
+			}
+			for (j = 0; j < g->degree[i] && seen[perm[g->G[i][j]]] == -(i + 1); j++)
+			{
+			}
+			if (j < g->degree[i])
+			{
+				break;
+			}
+		}
+		if (i < n)
+		{
+			printf("Automorphism %d of graph %d does not preserve its edges\n", g->n_gens + 1, src->graph_num + 1);
+			free(seen);
+			return EXIT_FAILURE;
+		}
+	}
+
+	free(seen);
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Loads graph src->graph_num + 1 of the binary graph file
+ * Rows of 32-bit entries are already laid out as adj, so the graph points into the file instead of
+ * copying them; 16-bit rows are widened into the graph's own buffer. Either way every entry is checked
+ * once, so a damaged file cannot send the search out of range.
+ */
+int load_graph(struct graph* g, struct source* src)
+{
+	struct csr_graph csr;
+	int i, j, own_rows;
+	uint32_t v = 0;
+
+	if (graph_file_get(&src->file, src->graph_num, &csr) != 0)
+	{
+		if (src->graph_num < src->file.n_graphs)
+		{
+			printf("Graph %d of the binary graph file is damaged\n", src->graph_num + 1);
+		}
+		return EXIT_FAILURE;
+	}
+
+	own_rows = csr.width != sizeof(int);
+	g->n = csr.n;
+	reserve_graph(g, csr.n, csr.n_adj, own_rows);
+	if (!own_rows)
+	{
+		// the mapping is read-only, which is safe as long as nothing writes to the rows
+		g->adj = (int*)csr.adj;
+	}
+
+	for (i = 0; i < g->n; i++)
+	{
+		// every row ends with the vertex itself, so it has at least one entry
+		if (csr.offsets[i + 1] <= csr.offsets[i] || csr.offsets[i + 1] > (uint32_t)csr.n_adj)
+		{
+			printf("Graph %d of the binary graph file is damaged\n", src->graph_num + 1);
+			return EXIT_FAILURE;
+		}
+		g->degree[i] = (int)(csr.offsets[i + 1] - csr.offsets[i]) - 1;
+
+		for (j = (int)csr.offsets[i]; j < (int)csr.offsets[i + 1]; j++)
+		{
+			v = csr_neighbour(&csr, j);
+			if (v >= (uint32_t)g->n)
+			{
+				printf("Graph %d of the binary graph file is damaged\n", src->graph_num + 1);
+				return EXIT_FAILURE;
+			}
+			if (own_rows)
+			{
+				g->adj[j] = (int)v;
+			}
+		}
+		if (v != (uint32_t)i)
+		{
+			printf("Graph %d of the binary graph file is damaged\n", src->graph_num + 1);
+			return EXIT_FAILURE;
+		}
+	}
+	link_rows(g);
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Reads in a graph from standard input
+ */
+int parse_graph(struct graph* g)
+{
+	// reads in input as long as end of file is not reached
+	if (read_int(&g->n) == 1 && g->n >= 1)
+	{
+		int i, j;
+		int n_adj = 0; // entries of adj in use
+
+		reserve_graph(g, g->n, 0, 1);
+
+		// for each vertex
+		for (i = 0; i < g->n; i++)
+		{
+			// read in its degree
+			if (read_int(&g->degree[i]) != 1 || g->degree[i] < 0)
+			{
+				return EXIT_FAILURE;
+			}
+
+			// the number of edges is only known at the end, so adj grows as the rows come in
+			reserve_graph(g, g->n, n_adj + g->degree[i] + 1, 1);
+
+			// for each degree
+			for (j = 0; j < g->degree[i]; j++)
+			{
+				// read in the vertex's neighbours
+				if (read_int(&g->adj[n_adj + j]) != 1)
+				{
+					return EXIT_FAILURE;
+				}
+
+				if (g->adj[n_adj + j] < 0 || g->adj[n_adj + j] >= g->n)
+				{
+					printf("A neighbour must be between 0 and %d", g->n - 1);
+					return EXIT_FAILURE;
+				}
+			}
+			g->adj[n_adj + g->degree[i]] = i;
+			n_adj += g->degree[i] + 1;
+		}
+		link_rows(g);
+		return EXIT_SUCCESS;
+	}
+	return EXIT_FAILURE;
+}
+
+/*
+ * Resizes an array to count elements of the given size, exiting if there is not enough memory
+ */
+void* resize_array(void* arr, size_t count, size_t size)
+{
+	arr = realloc(arr, count * size);
+	if (arr == NULL && count > 0)
+	{
+		printf("Not enough memory for the graph\n");
+		exit(EXIT_FAILURE);
+	}
+	return arr;
+}
+
+/*
+ * Makes room for a graph with n vertices and n_adj entries in its closed adjacency lists, whose rows
+ * are kept in adj_buf if own_rows is 1, or left in a mapped binary graph file if it is 0
+ * Arrays only grow, so a stream of graphs of similar size is allocated once
+ */
+void reserve_graph(struct graph* g, int n, int n_adj, int own_rows)
+{
+	if (n > g->n_cap)
+	{
+		g->degree = resize_array(g->degree, n, sizeof(int));
+		g->G = resize_array(g->G, n, sizeof(int*));
+		g->nb_count = resize_array(g->nb_count, n, sizeof(int));
+		g->nb_word = resize_array(g->nb_word, n, sizeof(int*));
+		g->nb_mask = resize_array(g->nb_mask, n, sizeof(uint64_t*));
+		g->n_cap = n;
+	}
+	if (n_adj > g->adj_cap)
+	{
+		// grow geometrically, as the rows of a text graph are added one at a time
+		if (n_adj < 2 * g->adj_cap)
+		{
+			n_adj = 2 * g->adj_cap;
+		}
+		g->nb_word_all = resize_array(g->nb_word_all, n_adj, sizeof(int));
+		g->nb_mask_all = resize_array(g->nb_mask_all, n_adj, sizeof(uint64_t));
+		g->adj_cap = n_adj;
+	}
+	if (own_rows)
+	{
+		if (g->adj_cap > g->adj_buf_cap)
+		{
+			g->adj_buf = resize_array(g->adj_buf, g->adj_cap, sizeof(int));
+			g->adj_buf_cap = g->adj_cap;
+		}
+		g->adj = g->adj_buf;
+	}
+}
+
+/*
+ * Points the rows of G, nb_word and nb_mask at their entries, degree[i] + 1 of them for vertex i
+ */
+void link_rows(struct graph* g)
+{
+	int i, start = 0;
+
+	for (i = 0; i < g->n; i++)
+	{
+		g->G[i] = g->adj + start;
+		g->nb_word[i] = g->nb_word_all + start;
+		g->nb_mask[i] = g->nb_mask_all + start;
+		start += g->degree[i] + 1;
+	}
+}
+
+/*
+ * Prints graph in verbose output mode
+ */
+void print_graph(struct out_writer* out, struct graph* g)
+{
+	int i, j;
+
+	out_int(out, g->n);
+	out_char(out, '\n');
+
+	for (i = 0; i < g->n; i++)
+	{
+		out_int(out, g->degree[i]);
+		out_char(out, ' ');
+		for (j = 0; j < g->degree[i]; j++)
+		{
+			out_int(out, g->G[i][j]);
+			out_char(out, ' ');
+		}
+		out_char(out, '\n');
+	}
+}
+
+/*
+ * Closes every neighbourhood and packs N[i] into (word, mask) pairs of the vertex bitset
+ */
+void build_neighbourhoods(struct graph* g)
+{
+	int i, j, k, v, w;
+
+	g->delta = 0;
+	g->regular = g->degree[0];
+	for (i = 0; i < g->n; i++)
+	{
+		if (g->degree[i] != g->regular)
+		{
+			g->regular = -1;
+		}
+
+		// find the maximum degree in a graph
+		if (g->degree[i] > g->delta)
+		{
+			g->delta = g->degree[i];
+		}
+
+		g->nb_count[i] = 0;
+		for (j = 0; j <= g->degree[i]; j++)
+		{
+			v = g->G[i][j];
+			w = v >> 6;
+
+			// neighbours are usually numbered close together, so most of N[i] shares a few words
+			for (k = 0; k < g->nb_count[i]; k++)
+			{
+				if (g->nb_word[i][k] == w)
+				{
+					break;
+				}
+			}
+			if (k == g->nb_count[i])
+			{
+				g->nb_word[i][k] = w;
+				g->nb_mask[i][k] = 0;
+				g->nb_count[i]++;
+			}
+			g->nb_mask[i][k] |= (uint64_t)1 << (v & 63);
+		}
+	}
+}
+
+/*
+ * Resets the search state to the root of the search tree
+ */
+void init_search(struct graph* g, struct search* s)
+{
+	int i;
+
+	s->n_dominated = 0;
+	s->n_dead = 0;
+	s->size = 0;
+	s->undo_top = 0;
+
+	for (i = 0; i < (g->n + 63) / 64; i++)
+	{
+		s->dominated[i] = 0;
+	}
+
+	s->max_choice = g->delta + 1;
+	for (i = 0; i <= s->max_choice; i++)
+	{
+		s->choice_head[i] = -1;
+	}
+
+	for (i = 0; i < g->n; i++)
+	{
+		s->num_choice[i] = g->degree[i] + 1;
+		s->dom[i] = 0;
+		s->blue[i] = 0;
+		if (s->dynamic)
+		{
+			insert_choice(s, i, s->num_choice[i]);
+		}
+	}
+}
+
+/*
+ * Adds undominated vertex v to the bucket of vertices with c choices
+ */
+void insert_choice(struct search* s, int v, int c)
+{
+	s->choice_prev[v] = -1;
+	s->choice_next[v] = s->choice_head[c];
+	if (s->choice_head[c] >= 0)
+	{
+		s->choice_prev[s->choice_head[c]] = v;
+	}
+	s->choice_head[c] = v;
+}
+
+/*
+ * Removes vertex v from the bucket of vertices with c choices
+ */
+void remove_choice(struct search* s, int v, int c)
+{
+	if (s->choice_prev[v] >= 0)
+	{
+		s->choice_next[s->choice_prev[v]] = s->choice_next[v];
+	}
+	else
+	{
+		s->choice_head[c] = s->choice_next[v];
+	}
+	if (s->choice_next[v] >= 0)
+	{
+		s->choice_prev[s->choice_next[v]] = s->choice_prev[v];
+	}
+}
+
+/*
+ * Returns an undominated vertex with the fewest choices left, or -1 if every vertex is dominated
+ * Vertices with no choices are never selected as the search backtracks as soon as one appears
+ */
+int select_vertex(struct search* s)
+{
+	int c;
+
+	for (c = 1; c <= s->max_choice; c++)
+	{
+		if (s->choice_head[c] >= 0)
+		{
+			return s->choice_head[c];
+		}
+	}
+	return -1;
+}
+
+/*
+ * Colours vertex u blue, in the search kernel for D-regular graphs (D = 0 for any graph)
+ */
+static inline __attribute__((always_inline)) void colour_blue_kernel(struct graph* g, struct search* s, int u, const int D)
+{
+	const int* row = KERNEL_ROW(g, G, adj, u, D);
+	const int degree = KERNEL_DEGREE(g, u, D);
+	int i, v;
+
+	s->blue[u] = 1;
+
+#pragma GCC unroll 9
+	for (i = 0; i <= degree; i++)
+	{
+		v = row[i];
+		// undominated vertices move to the bucket below
+		if (s->dynamic && !(s->dominated[v >> 6] >> (v & 63) & 1))
+		{
+			remove_choice(s, v, s->num_choice[v]);
+			insert_choice(s, v, s->num_choice[v] - 1);
+		}
+		// a vertex with no choices left can never be dominated
+		if (--s->num_choice[v] == 0)
+		{
+			s->n_dead++;
+		}
+	}
+}
+
+/*
+ * Undoes colouring vertex u blue (colours it white)
+ */
+static inline __attribute__((always_inline)) void uncolour_blue_kernel(struct graph* g, struct search* s, int u, const int D)
+{
+	const int* row = KERNEL_ROW(g, G, adj, u, D);
+	const int degree = KERNEL_DEGREE(g, u, D);
+	int i, v;
+
+	s->blue[u] = 0;
+
+#pragma GCC unroll 9
+	for (i = 0; i <= degree; i++)
+	{
+		v = row[i];
+		if (s->dynamic && !(s->dominated[v >> 6] >> (v & 63) & 1))
+		{
+			remove_choice(s, v, s->num_choice[v]);
+			insert_choice(s, v, s->num_choice[v] + 1);
+		}
+		if (s->num_choice[v]++ == 0)
+		{
+			s->n_dead--;
+		}
+	}
+}
+
+/*
+ * Colours vertex u red, saving the bitset words it overwrites
+ */
+static inline __attribute__((always_inline)) void colour_red_kernel(struct graph* g, struct search* s, int u, uint64_t saved[], const int D)
+{
+	const int* word = KERNEL_ROW(g, nb_word, nb_word_all, u, D);
+	const uint64_t* mask = KERNEL_ROW(g, nb_mask, nb_mask_all, u, D);
+	int k, w, v;
+	uint64_t bits;
+
+	s->dom[u] = 1;
+	s->size++;
+
+	for (k = 0; k < g->nb_count[u]; k++)
+	{
+		w = word[k];
+		saved[k] = s->dominated[w];
+		s->dominated[w] |= mask[k];
+		bits = s->dominated[w] & ~saved[k];
+		// increase number of dominated vertices by the newly set bits
+		s->n_dominated += __builtin_popcountll(bits);
+
+		// newly dominated vertices leave the buckets
+		for (; s->dynamic && bits != 0; bits &= bits - 1)
+		{
+			v = (w << 6) + __builtin_ctzll(bits);
+			remove_choice(s, v, s->num_choice[v]);
+		}
+	}
+}
+
+/*
+ * Undoes colouring vertex u red (colours it white)
+ */
+static inline __attribute__((always_inline)) void uncolour_red_kernel(struct graph* g, struct search* s, int u, uint64_t saved[], const int D)
+{
+	const int* word = KERNEL_ROW(g, nb_word, nb_word_all, u, D);
+	int k, w, v;
+	uint64_t bits;
+
+	s->dom[u] = 0;
+	s->size--;
+
+	for (k = 0; k < g->nb_count[u]; k++)
+	{
+		w = word[k];
+		bits = s->dominated[w] & ~saved[k];
+		// decrease number of dominated vertices by the bits being cleared
+		s->n_dominated -= __builtin_popcountll(bits);
+		s->dominated[w] = saved[k];
+
+		// vertices that are undominated again go back into the buckets
+		for (; s->dynamic && bits != 0; bits &= bits - 1)
+		{
+			v = (w << 6) + __builtin_ctzll(bits);
+			insert_choice(s, v, s->num_choice[v]);
+		}
+	}
+}
+
+/*
+ * Colours vertex u blue
+ */
+void colour_blue(struct graph* g, struct search* s, int u)
+{
+	colour_blue_kernel(g, s, u, 0);
+}
+
+/*
+ * Undoes colouring vertex u blue (colours it white)
+ */
+void uncolour_blue(struct graph* g, struct search* s, int u)
+{
+	uncolour_blue_kernel(g, s, u, 0);
+}
+
+/*
+ * Colours vertex u red, saving the bitset words it overwrites
+ */
+void colour_red(struct graph* g, struct search* s, int u, uint64_t saved[])
+{
+	colour_red_kernel(g, s, u, saved, 0);
+}
+
+/*
+ * Undoes colouring vertex u red (colours it white)
+ */
+void uncolour_red(struct graph* g, struct search* s, int u, uint64_t saved[])
+{
+	uncolour_red_kernel(g, s, u, saved, 0);
+}
+
+/*
+ * Replaces the shared minimum dominating set if the current one is smaller
+ */
+void record_dom_set(struct graph* g, struct search* s)
+{
+	struct incumbent* best = &s->pool->best;
+	int i;
+
+	pthread_mutex_lock(&best->lock);
+	if (s->size < atomic_load(&best->size))
+	{
+		for (i = 0; i < g->n; i++)
+		{
+			best->dom[i] = s->dom[i];
+		}
+		atomic_store(&best->size, s->size);
+	}
+	pthread_mutex_unlock(&best->lock);
+}
+
+/*
+ * Counts CHECK_INTERVAL more search nodes and checks the time and node limits
+ * Returns 1 if the search of the current graph should stop
+ */
+int check_limits(struct search* s)
+{
+	struct pool* p = s->pool;
+	struct options* opt = p->opt;
+	struct timespec now;
+	long long nodes;
+
+	s->nodes = 0;
+	nodes = atomic_fetch_add(&p->nodes, CHECK_INTERVAL) + CHECK_INTERVAL;
+
+	if (opt->node_limit > 0 && nodes >= opt->node_limit && !atomic_exchange(&p->stop, 1))
+	{
+		wake_workers(p, 1);
+	}
+	if (opt->time_limit > 0)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		if ((now.tv_sec - p->start.tv_sec) + (now.tv_nsec - p->start.tv_nsec) / 1e9 >= opt->time_limit
+			&& !atomic_exchange(&p->stop, 1))
+		{
+			wake_workers(p, 1);
+		}
+	}
+	return atomic_load(&p->stop);
+}
+
+/*
+ * Finds a minimum dominating set of a graph, starting from the root of the current task
+ * With static branching, level is the first vertex not coloured by the task
+ * Coluring: red = in dominating set, blue = excluded from dominating set, white = undecided
+ * With D > 0 the graph must be D-regular: every loop over a closed neighbourhood then has a fixed
+ * trip count and is unrolled, and the degree bound divides by a constant
+ */
+static inline __attribute__((always_inline)) void min_dom_set_kernel(int level, struct graph* g, struct search* s, const int D)
+{
+	const int delta = D > 0 ? D : g->delta;
+	const char* fixed = s->pool->reduce.fixed;
+	struct symmetry* sym = &s->pool->sym;
+	const int* row;
+	struct decision* d;
+	int depth = 0; // number of decisions on the trail
+	int min_size, n_extra, i, u, v;
+
+	for (;;)
+	{
+		// give up on the graph once a limit is reached, keeping the best set found so far
+		if (++s->nodes == CHECK_INTERVAL && check_limits(s))
+		{
+			return;
+		}
+
+		// vertices coloured by the reduction rules are not branched on
+		while (level < g->n && fixed[level] != FIXED_WHITE)
+		{
+			level++;
+		}
+
+		// another worker may have lowered the minimum at any time
+		min_size = atomic_load_explicit(&s->pool->best.size, memory_order_relaxed);
+
+#if DEBUG
+		printf("\nLevel %3d: \n", level);
+		printf("Current dominating set:\n");
+		print_vector(g->n, s->dom);
+		printf("Number of vertices dominated: %3d\n", s->n_dominated);
+		printf("Number of vertices that cannot be dominated: %3d\n", s->n_dead);
+		printf("Number of choices per vertex:\n");
+		print_vector(g->n, s->num_choice);
+		printf("Size is: %d, min_size is: %d\n", s->size, min_size);
+#endif
+
+		u = g->n - s->n_dominated; // number of undominated vertices
+		n_extra = (u + delta)/(delta + 1);
+
+		// backtrack if some vertex has every vertex of its closed neighbourhood coloured blue,
+		// if the current set cannot beat the minimum, or if a symmetric image of it is searched instead
+		if (s->n_dead == 0 && s->size + n_extra < min_size && (sym->n_gens == 0 || !lex_smaller(g, s, sym)))
+		{
+			if (s->n_dominated == g->n || (!s->dynamic && level == g->n))
+			{
+				record_dom_set(g, s);
+			}
+			else if (!s->dynamic)
+			{
+				// exhaustive backtrack: try colouring a vertex blue
+				d = &s->trail[depth++];
+				d->vertex = level;
+				d->red = 0;
+				d->second = 0;
+				d->anchor = -1;
+				colour_blue_kernel(g, s, level, D);
+				level++;
+				continue;
+			}
+			else
+			{
+				// keep branching over the same closed neighbourhood after one of its vertices turned blue,
+				// otherwise pick the undominated vertex with the fewest choices
+				if (depth > 0 && s->trail[depth - 1].second)
+				{
+					v = s->trail[depth - 1].anchor;
+				}
+				else
+				{
+					v = select_vertex(s);
+				}
+
+				// try colouring the next white vertex of N[v] red
+				row = KERNEL_ROW(g, G, adj, v, D);
+				for (i = 0; i <= KERNEL_DEGREE(g, v, D); i++)
+				{
+					u = row[i];
+					if (!s->dom[u] && !s->blue[u])
+					{
+						break;
+					}
+				}
+
+				d = &s->trail[depth++];
+				d->vertex = u;
+				d->red = 1;
+				d->second = 0;
+				d->anchor = v;
+				colour_red_kernel(g, s, u, &s->undo[s->undo_top], D);
+				s->undo_top += g->nb_count[u];
+				continue;
+			}
+		}
+
+		// backtrack to the deepest decision whose second colour has not been tried yet
+		for (;;)
+		{
+			if (depth == 0)
+			{
+				return;
+			}
+			d = &s->trail[depth - 1];
+			u = d->vertex;
+
+			// undo the current colour (colour the vertex white)
+			if (d->red)
+			{
+				s->undo_top -= g->nb_count[u];
+				uncolour_red_kernel(g, s, u, &s->undo[s->undo_top], D);
+			}
+			else
+			{
+				uncolour_blue_kernel(g, s, u, D);
+			}
+
+			if (d->second)
+			{
+				depth--;
+				continue;
+			}
+
+			// near the root, leave the second branch to whichever worker gets to it first
+			if (s->task.n_decisions + depth - 1 < s->pool->split_level)
+			{
+				struct task t = s->task;
+
+				for (i = 0; i < depth; i++)
+				{
+					t.vertex[t.n_decisions] = s->trail[i].vertex;
+					t.red[t.n_decisions] = s->trail[i].red;
+					t.n_decisions++;
+				}
+				t.red[t.n_decisions - 1] = !d->red;
+				push_task(s->pool, s->id, &t);
+				depth--;
+				continue;
+			}
+
+			// try the second colour
+			d->red = !d->red;
+			d->second = 1;
+			if (d->red)
+			{
+				colour_red_kernel(g, s, u, &s->undo[s->undo_top], D);
+				s->undo_top += g->nb_count[u];
+			}
+			else
+			{
+				colour_blue_kernel(g, s, u, D);
+			}
+			level = u + 1;
+			break;
+		}
+	}
+}
+
+/*
+ * Search kernels: one for any graph, and one for each degree of regular graph common in the input
+ * (cubic cages, 4-regular grids and cycle products, hypercubes)
+ */
+void min_dom_set(int level, struct graph* g, struct search* s)
+{
+	min_dom_set_kernel(level, g, s, 0);
+}
+
+void min_dom_set_3(int level, struct graph* g, struct search* s)
+{
+	min_dom_set_kernel(level, g, s, 3);
+}
+
+void min_dom_set_4(int level, struct graph* g, struct search* s)
+{
+	min_dom_set_kernel(level, g, s, 4);
+}
+
+void min_dom_set_6(int level, struct graph* g, struct search* s)
+{
+	min_dom_set_kernel(level, g, s, 6);
+}
+
+void min_dom_set_8(int level, struct graph* g, struct search* s)
+{
+	min_dom_set_kernel(level, g, s, 8);
+}
+
+/*
+ * Picks the search kernel the workers run on a graph whose neighbourhoods are built
+ */
+void select_search(struct pool* p, struct graph* g)
+{
+	switch (g->regular)
+	{
+	case 3:
+		p->search = min_dom_set_3;
+		break;
+	case 4:
+		p->search = min_dom_set_4;
+		break;
+	case 6:
+		p->search = min_dom_set_6;
+		break;
+	case 8:
+		p->search = min_dom_set_8;
+		break;
+	default:
+		p->search = min_dom_set;
+	}
+}
+
+/*
+ * Adds a task to the tail of a worker's deque
+ */
+void push_task(struct pool* p, int id, struct task* t)
+{
+	struct deque* d = &p->deques[id];
+
+	atomic_fetch_add(&p->pending, 1);
+
+	pthread_mutex_lock(&d->lock);
+	if (d->tail == d->capacity)
+	{
+		// slide the live tasks to the front, or grow the deque if it is full
+		if (d->head > 0)
+		{
+			memmove(d->tasks, d->tasks + d->head, (d->tail - d->head) * sizeof(struct task));
+			d->tail -= d->head;
+			d->head = 0;
+		}
+		else
+		{
+			struct task* tasks = realloc(d->tasks, 2 * d->capacity * sizeof(struct task));
+			if (tasks == NULL)
+			{
+				printf("Not enough memory for the task deque\n");
+				exit(EXIT_FAILURE);
+			}
+			d->tasks = tasks;
+			d->capacity *= 2;
+		}
+	}
+	d->tasks[d->tail++] = *t;
+	pthread_mutex_unlock(&d->lock);
+
+	atomic_fetch_add(&p->queued, 1);
+	wake_workers(p, 0);
+}
+
+/*
+ * Wakes one idle worker after a task is pushed, or all of them once the search ends
+ * The lock is taken so that a worker about to wait cannot miss the wakeup.
+ */
+void wake_workers(struct pool* p, int all)
+{
+	pthread_mutex_lock(&p->idle_lock);
+	if (all)
+	{
+		pthread_cond_broadcast(&p->idle);
+	}
+	else
+	{
+		pthread_cond_signal(&p->idle);
+	}
+	pthread_mutex_unlock(&p->idle_lock);
+}
+
+/*
+ * Takes the newest task of a worker's own deque, or steals the oldest task of another worker
+ * Returns 1 if a task was found
+ */
+int pop_task(struct pool* p, int id, struct task* t)
+{
+	struct deque* d = &p->deques[id];
+	int i, found = 0;
+
+	pthread_mutex_lock(&d->lock);
+	if (d->tail > d->head)
+	{
+		*t = d->tasks[--d->tail];
+		found = 1;
+	}
+	pthread_mutex_unlock(&d->lock);
+
+	for (i = 1; i < p->n_workers && !found; i++)
+	{
+		d = &p->deques[(id + i) % p->n_workers];
+
+		pthread_mutex_lock(&d->lock);
+		if (d->tail > d->head)
+		{
+			*t = d->tasks[d->head++];
+			found = 1;
+		}
+		pthread_mutex_unlock(&d->lock);
+	}
+	if (found)
+	{
+		atomic_fetch_sub(&p->queued, 1);
+	}
+	return found;
+}
+
+/*
+ * Searches tasks until there are none left anywhere
+ */
+void* worker(void* arg)
+{
+	struct search* s = arg;
+	struct pool* p = s->pool;
+	struct graph* g = p->g;
+	struct task t;
+	int i;
+
+	s->nodes = 0;
+	while (atomic_load(&p->pending) > 0 && !atomic_load(&p->stop))
+	{
+		if (!pop_task(p, s->id, &t))
+		{
+			// sleep until a task is pushed or the search ends
+			pthread_mutex_lock(&p->idle_lock);
+			while (atomic_load(&p->queued) == 0 && atomic_load(&p->pending) > 0 && !atomic_load(&p->stop))
+			{
+				pthread_cond_wait(&p->idle, &p->idle_lock);
+			}
+			pthread_mutex_unlock(&p->idle_lock);
+			continue;
+		}
+
+		// replay the colours that lead to the subtree; they are never undone, so the words they
+		// overwrite need not be kept
+		s->dynamic = p->opt->dynamic;
+		s->task = t;
+		init_search(g, s);
+		apply_reduction(g, s, &p->reduce);
+		for (i = 0; i < t.n_decisions; i++)
+		{
+			if (t.red[i])
+			{
+				colour_red(g, s, t.vertex[i], s->undo);
+			}
+			else
+			{
+				colour_blue(g, s, t.vertex[i]);
+			}
+		}
+
+		// with static branching, the search carries on after the last vertex coloured by the task
+		p->search(t.n_decisions > 0 ? t.vertex[t.n_decisions - 1] + 1 : 0, g, s);
+
+		if (atomic_fetch_sub(&p->pending, 1) == 1)
+		{
+			wake_workers(p, 1);
+		}
+	}
+	return NULL;
+}
+
+/*
+ * Returns the larger of the degree bound and the MDD bound with no vertex coloured
+ * Every vertex v needs a red vertex in N[v], and that vertex dominates at most max_dom_degree[v]
+ * vertices, the largest closed neighbourhood within N[v]
+ */
+int root_lower_bound(struct graph* g, struct heuristic* h)
+{
+	int i, j, d, max, count, jumps;
+	int skip = 0;
+	int mdd = 0;
+
+	for (d = 0; d <= g->delta + 1; d++)
+	{
+		h->mdd_count[d] = 0;
+	}
+	for (i = 0; i < g->n; i++)
+	{
+		max = 0;
+		for (j = 0; j <= g->degree[i]; j++)
+		{
+			if (g->degree[g->G[i][j]] + 1 > max)
+			{
+				max = g->degree[g->G[i][j]] + 1;
+			}
+		}
+		h->mdd_count[max]++;
+	}
+
+	// walk the vertices in ascending order of max_dom_degree, one bucket at a time
+	for (d = 1; d <= g->delta + 1; d++)
+	{
+		count = h->mdd_count[d];
+		if (skip >= count)
+		{
+			skip -= count;
+			continue;
+		}
+		count -= skip;
+		jumps = (count + d - 1) / d;
+		mdd += jumps;
+		skip = jumps * d - count;
+	}
+
+	d = (g->n + g->delta) / (g->delta + 1);
+	return mdd > d ? mdd : d;
+}
+
+/*
+ * Returns 1 if x is in N[u]
+ */
+int in_closed_neighbourhood(struct graph* g, int u, int x)
+{
+	int k;
+
+	for (k = 0; k < g->nb_count[u]; k++)
+	{
+		if (g->nb_word[u][k] == x >> 6)
+		{
+			return g->nb_mask[u][k] >> (x & 63) & 1;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Adds vertex v to the heuristic dominating set
+ */
+void add_to_set(struct graph* g, struct heuristic* h, int v)
+{
+	int i;
+
+	h->in_set[v] = 1;
+	h->size++;
+	for (i = 0; i <= g->degree[v]; i++)
+	{
+		h->count[g->G[v][i]]++;
+	}
+}
+
+/*
+ * Removes vertex v from the heuristic dominating set
+ */
+void remove_from_set(struct graph* g, struct heuristic* h, int v)
+{
+	int i;
+
+	h->in_set[v] = 0;
+	h->size--;
+	for (i = 0; i <= g->degree[v]; i++)
+	{
+		h->count[g->G[v][i]]--;
+	}
+}
+
+/*
+ * Returns 1 if every vertex of N[v] is dominated by some other vertex of the set
+ */
+int is_redundant(struct graph* g, struct heuristic* h, int v)
+{
+	int i;
+
+	for (i = 0; i <= g->degree[v]; i++)
+	{
+		if (h->count[g->G[v][i]] < 2)
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * Builds a dominating set by repeatedly adding the vertex that dominates the most undominated vertices
+ * Vertices sit in buckets by coverage, and are only moved down when found in a bucket that is too high
+ */
+void greedy_dom_set(struct graph* g, struct heuristic* h)
+{
+	int i, j, v, x;
+	int top = g->delta + 1; // highest bucket that may not be empty
+	int n_dominated = 0;
+
+	for (i = 0; i <= g->delta + 1; i++)
+	{
+		h->head[i] = -1;
+	}
+	h->size = 0;
+	for (v = 0; v < g->n; v++)
+	{
+		h->in_set[v] = 0;
+		h->count[v] = 0;
+		h->cov[v] = g->degree[v] + 1;
+		h->next[v] = h->head[h->cov[v]];
+		h->head[h->cov[v]] = v;
+	}
+
+	while (n_dominated < g->n)
+	{
+		while (h->head[top] < 0)
+		{
+			top--;
+		}
+		v = h->head[top];
+		h->head[top] = h->next[v];
+
+		// lazy update: a vertex whose coverage dropped goes back in its current bucket
+		if (h->cov[v] < top)
+		{
+			h->next[v] = h->head[h->cov[v]];
+			h->head[h->cov[v]] = v;
+			continue;
+		}
+
+		add_to_set(g, h, v);
+		for (i = 0; i <= g->degree[v]; i++)
+		{
+			x = g->G[v][i];
+			if (h->count[x] == 1)
+			{
+				// x is newly dominated, so none of its neighbours covers it any more
+				n_dominated++;
+				for (j = 0; j <= g->degree[x]; j++)
+				{
+					h->cov[g->G[x][j]]--;
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Tries to replace v by one vertex u that dominates everything only v dominated,
+ * such that some other vertex of the set becomes redundant
+ * Returns 1 if the set got smaller
+ */
+int swap_dom_set(struct graph* g, struct heuristic* h, int v)
+{
+	int i, j, k, u, x, y, w, covers;
+	int x0 = -1; // a vertex left undominated without v
+
+	remove_from_set(g, h, v);
+	for (i = 0; i <= g->degree[v]; i++)
+	{
+		if (h->count[g->G[v][i]] == 0)
+		{
+			x0 = g->G[v][i];
+			break;
+		}
+	}
+	if (x0 < 0)
+	{
+		// v was redundant
+		return 1;
+	}
+
+	// u must dominate x0, so it is in N[x0]
+	for (i = 0; i <= g->degree[x0]; i++)
+	{
+		u = g->G[x0][i];
+		if (u == v || h->in_set[u])
+		{
+			continue;
+		}
+
+		covers = 1;
+		for (j = 0; j <= g->degree[v] && covers; j++)
+		{
+			x = g->G[v][j];
+			if (h->count[x] == 0 && !in_closed_neighbourhood(g, u, x))
+			{
+				covers = 0;
+			}
+		}
+		if (!covers)
+		{
+			continue;
+		}
+
+		// vertices made redundant by u are within distance 2 of u
+		add_to_set(g, h, u);
+		for (j = 0; j <= g->degree[u]; j++)
+		{
+			y = g->G[u][j];
+			for (k = 0; k <= g->degree[y]; k++)
+			{
+				w = g->G[y][k];
+				if (w != u && h->in_set[w] && is_redundant(g, h, w))
+				{
+					remove_from_set(g, h, w);
+					return 1;
+				}
+			}
+		}
+		remove_from_set(g, h, u);
+	}
+
+	add_to_set(g, h, v);
+	return 0;
+}
+
+/*
+ * Removes redundant vertices from the heuristic dominating set, then swaps vertices
+ * until no swap makes the set smaller
+ */
+void improve_dom_set(struct graph* g, struct heuristic* h)
+{
+	int v, improved = 1;
+
+	// the vertices picked last by the greedy set cover the least, so they are dropped first
+	for (v = g->n - 1; v >= 0; v--)
+	{
+		if (h->in_set[v] && is_redundant(g, h, v))
+		{
+			remove_from_set(g, h, v);
+		}
+	}
+
+	while (improved)
+	{
+		improved = 0;
+		for (v = 0; v < g->n; v++)
+		{
+			if (h->in_set[v] && swap_dom_set(g, h, v))
+			{
+				improved = 1;
+			}
+		}
+	}
+}
+
+/*
+ * Applies the reduction rules to a graph whose neighbourhoods are built, until none applies
+ * Some minimum dominating set contains every vertex forced red and no vertex forced blue, and
+ * dominates the ignored vertices once it dominates the others. With apply = 0 every vertex is left white.
+ */
+void reduce_graph(struct graph* g, struct reduction* r, int apply)
+{
+	int i, v;
+
+	r->head = 0;
+	r->length = 0;
+	r->stamp = 0;
+	r->n_red = 0;
+	r->n_blue = 0;
+	r->n_ignored = 0;
+	for (i = 0; i < g->n; i++)
+	{
+		r->fixed[i] = FIXED_WHITE;
+		r->covered[i] = 0;
+		r->ignored[i] = 0;
+		r->n_cand[i] = g->degree[i] + 1;
+		r->queued[i] = 0;
+		r->mark[i] = 0;
+		r->seen[i] = 0;
+	}
+
+	if (!apply)
+	{
+		return;
+	}
+
+	// every vertex is checked once, and again whenever a change nearby may let a rule apply to it
+	for (i = 0; i < g->n; i++)
+	{
+		enqueue_vertex(g, r, i);
+	}
+	while (r->length > 0)
+	{
+		v = r->queue[r->head];
+		r->head = (r->head + 1) % g->n;
+		r->length--;
+		r->queued[v] = 0;
+		reduce_vertex(g, r, v);
+	}
+
+#if DEBUG
+	printf("Reduction: %d red, %d blue, %d ignored of %d vertices\n", r->n_red, r->n_blue, r->n_ignored, g->n);
+#endif
+}
+
+/*
+ * Applies the first rule that applies to vertex v, if any
+ */
+void reduce_vertex(struct graph* g, struct reduction* r, int v)
+{
+	int live = !r->covered[v] && !r->ignored[v];
+	int i, j, k, c, w, y, count, subset;
+
+	// a live vertex with one choice left has to be dominated by it, as a leaf is by its support
+	if (live && r->n_cand[v] == 1)
+	{
+		for (i = 0; r->fixed[g->G[v][i]] == FIXED_BLUE; i++)
+		{
+		}
+		force_red(g, r, g->G[v][i]);
+		return;
+	}
+
+	// a white vertex is not needed if the live vertices it dominates are all dominated by
+	// another white vertex, which can take its place in any dominating set
+	if (r->fixed[v] == FIXED_WHITE)
+	{
+		r->stamp++;
+		k = 0;
+		y = -1;
+		for (i = 0; i <= g->degree[v]; i++)
+		{
+			w = g->G[v][i];
+			if (!r->covered[w] && !r->ignored[w])
+			{
+				r->mark[w] = r->stamp;
+				y = w;
+				k++;
+			}
+		}
+
+		// only vertices next to y can dominate all of them
+		for (i = 0; y >= 0 && i <= g->degree[y]; i++)
+		{
+			w = g->G[y][i];
+			if (w == v || r->fixed[w] != FIXED_WHITE)
+			{
+				continue;
+			}
+			count = 0;
+			for (j = 0; j <= g->degree[w]; j++)
+			{
+				if (r->mark[g->G[w][j]] == r->stamp)
+				{
+					count++;
+				}
+			}
+			if (count == k)
+			{
+				break;
+			}
+		}
+		if (y < 0 || i <= g->degree[y])
+		{
+			force_blue(g, r, v);
+			return;
+		}
+	}
+
+	// a live vertex can be ignored if every choice of another live vertex y is also one of its
+	// choices, as dominating y then dominates it
+	if (live)
+	{
+		r->stamp++;
+		for (i = 0; i <= g->degree[v]; i++)
+		{
+			c = g->G[v][i];
+			if (r->fixed[c] != FIXED_BLUE)
+			{
+				r->mark[c] = r->stamp;
+			}
+		}
+
+		// y shares a choice with v, so it is next to one
+		for (i = 0; i <= g->degree[v]; i++)
+		{
+			c = g->G[v][i];
+			if (r->fixed[c] == FIXED_BLUE)
+			{
+				continue;
+			}
+			for (j = 0; j <= g->degree[c]; j++)
+			{
+				y = g->G[c][j];
+				if (y == v || r->seen[y] == r->stamp || r->covered[y] || r->ignored[y] || r->n_cand[y] > r->n_cand[v])
+				{
+					continue;
+				}
+				r->seen[y] = r->stamp;
+
+				subset = 1;
+				for (k = 0; k <= g->degree[y] && subset; k++)
+				{
+					w = g->G[y][k];
+					subset = r->fixed[w] == FIXED_BLUE || r->mark[w] == r->stamp;
+				}
+				if (subset)
+				{
+					ignore_vertex(g, r, v);
+					return;
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Forces white vertex u red
+ */
+void force_red(struct graph* g, struct reduction* r, int u)
+{
+	int i, j, z;
+
+	r->fixed[u] = FIXED_RED;
+	r->n_red++;
+
+	for (i = 0; i <= g->degree[u]; i++)
+	{
+		z = g->G[u][i];
+		if (r->covered[z])
+		{
+			continue;
+		}
+		r->covered[z] = 1;
+
+		// white vertices next to z now dominate fewer live vertices
+		if (!r->ignored[z])
+		{
+			for (j = 0; j <= g->degree[z]; j++)
+			{
+				enqueue_vertex(g, r, g->G[z][j]);
+			}
+		}
+	}
+}
+
+/*
+ * Forces white vertex u blue
+ */
+void force_blue(struct graph* g, struct reduction* r, int u)
+{
+	int i, j, y, c;
+
+	r->fixed[u] = FIXED_BLUE;
+	r->n_blue++;
+
+	for (i = 0; i <= g->degree[u]; i++)
+	{
+		y = g->G[u][i];
+		r->n_cand[y]--;
+		enqueue_vertex(g, r, y);
+
+		// y has fewer choices, so vertices next to all of them, all next to its first choice c,
+		// may now be ignored
+		for (j = 0; j <= g->degree[y] && r->fixed[g->G[y][j]] == FIXED_BLUE; j++)
+		{
+		}
+		if (j <= g->degree[y])
+		{
+			c = g->G[y][j];
+			for (j = 0; j <= g->degree[c]; j++)
+			{
+				enqueue_vertex(g, r, g->G[c][j]);
+			}
+		}
+	}
+}
+
+/*
+ * Ignores live vertex x
+ */
+void ignore_vertex(struct graph* g, struct reduction* r, int x)
+{
+	int i;
+
+	r->ignored[x] = 1;
+	r->n_ignored++;
+
+	// white vertices next to x now dominate fewer live vertices
+	for (i = 0; i <= g->degree[x]; i++)
+	{
+		enqueue_vertex(g, r, g->G[x][i]);
+	}
+}
+
+/*
+ * Adds vertex v to the queue of vertices to check, unless it is already there
+ */
+void enqueue_vertex(struct graph* g, struct reduction* r, int v)
+{
+	if (!r->queued[v])
+	{
+		r->queued[v] = 1;
+		r->queue[(r->head + r->length) % g->n] = v;
+		r->length++;
+	}
+}
+
+/*
+ * Colours the search state at the root as the reduction rules force
+ * Ignored vertices count as dominated from the start, and can never run out of choices
+ */
+void apply_reduction(struct graph* g, struct search* s, struct reduction* r)
+{
+	int i;
+
+	for (i = 0; i < g->n; i++)
+	{
+		if (r->ignored[i] && !r->covered[i])
+		{
+			if (s->dynamic)
+			{
+				remove_choice(s, i, s->num_choice[i]);
+			}
+			s->dominated[i >> 6] |= (uint64_t)1 << (i & 63);
+			s->n_dominated++;
+			s->num_choice[i] += g->n + 1;
+		}
+	}
+
+	// the words overwritten at the root are never restored
+	for (i = 0; i < g->n; i++)
+	{
+		if (r->fixed[i] == FIXED_RED)
+		{
+			colour_red(g, s, i, s->undo);
+		}
+		else if (r->fixed[i] == FIXED_BLUE)
+		{
+			colour_blue(g, s, i);
+		}
+	}
+}
+
+/*
+ * Sets up symmetry breaking with the automorphisms given with the graph, or found by search
+ * If the orbit of vertex 0 contains a whole closed neighbourhood, every dominating set has an image
+ * containing vertex 0, so vertex 0 is forced red. Reduction rules pick particular members of an
+ * orbit, so symmetry is not broken once they have forced any colour.
+ */
+void break_symmetry(struct graph* g, struct pool* p)
+{
+	struct symmetry* sym = &p->sym;
+	struct reduction* r = &p->reduce;
+	int i, j, k, v, head, tail;
+	size_t n_moved = 0;
+
+	sym->n_gens = 0;
+	if (r->n_red > 0 || r->n_blue > 0)
+	{
+		return;
+	}
+	if (g->n_gens > 0)
+	{
+		sym->gens = g->gens;
+		k = g->n_gens;
+	}
+	else if (p->opt->symmetry && find_automorphisms(&sym->aut, g->n, g->degree, g->G, SYMMETRY_BUDGET) >= 0)
+	{
+		sym->gens = sym->aut.gens;
+		k = sym->aut.n_gens;
+	}
+	else
+	{
+		return;
+	}
+
+	// the lexicographic comparison only has to look at the vertices a generator moves
+	if (k + 1 > sym->start_cap)
+	{
+		sym->start_cap = k + 1;
+		sym->moved_start = resize_array(sym->moved_start, sym->start_cap, sizeof(int));
+	}
+	for (i = 0; i < k; i++)
+	{
+		sym->moved_start[i] = (int)n_moved;
+		for (v = 0; v < g->n; v++)
+		{
+			if (sym->gens[(size_t)i * g->n + v] == v)
+			{
+				continue;
+			}
+			if (n_moved == sym->moved_cap)
+			{
+				sym->moved_cap = sym->moved_cap > 0 ? 2 * sym->moved_cap : (size_t)g->n;
+				sym->moved = resize_array(sym->moved, sym->moved_cap, sizeof(int));
+			}
+			sym->moved[n_moved++] = v;
+		}
+	}
+	sym->moved_start[k] = (int)n_moved;
+	sym->n_gens = k;
+
+	// orbit of vertex 0, with the queue of the reduction rules as the queue and its marks as marks
+	r->stamp++;
+	r->mark[0] = r->stamp;
+	r->queue[0] = 0;
+	for (head = 0, tail = 1; head < tail; head++)
+	{
+		for (i = 0; i < k; i++)
+		{
+			v = sym->gens[(size_t)i * g->n + r->queue[head]];
+			if (r->mark[v] != r->stamp)
+			{
+				r->mark[v] = r->stamp;
+				r->queue[tail++] = v;
+			}
+		}
+	}
+
+	for (v = 0; v < g->n; v++)
+	{
+		for (j = 0; j <= g->degree[v] && r->mark[g->G[v][j]] == r->stamp; j++)
+		{
+		}
+		if (j > g->degree[v])
+		{
+			r->fixed[0] = FIXED_RED;
+			r->n_red = 1;
+			break;
+		}
+	}
+
+#if DEBUG
+	printf("Symmetry: %d generators, orbit of vertex 0 has %d vertices\n", k, tail);
+#endif
+}
+
+/*
+ * Returns 1 if the current colouring makes the dominating set lexicographically smaller than its
+ * image under some generator, whatever colours the white vertices get
+ */
+int lex_smaller(struct graph* g, struct search* s, struct symmetry* sym)
+{
+	const int* perm;
+	int k, j, v, a, b;
+
+	for (k = 0; k < sym->n_gens; k++)
+	{
+		perm = sym->gens + (size_t)k * g->n;
+		for (j = sym->moved_start[k]; j < sym->moved_start[k + 1]; j++)
+		{
+			// compare vertex v with its image, 2 for red, 1 for blue, 0 for white
+			v = sym->moved[j];
+			a = s->dom[v] ? 2 : s->blue[v];
+			b = s->dom[perm[v]] ? 2 : s->blue[perm[v]];
+			if (a == 0 || b == 0 || a > b)
+			{
+				break;
+			}
+			if (a < b)
+			{
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+/*
+ * Finds a minimum dominating set of a graph with the given workers
+ * A set dominates a disconnected graph exactly when it dominates every component, so the components
+ * are searched one after another, each with its own bounds, and their minimums added up. Otherwise
+ * the search would explore the product of the components' search spaces instead of their sum.
+ */
+void solve(struct graph* g, struct pool* p, struct search* workers[])
+{
+	struct components* c = &p->parts;
+	int size = 0, lower = 0, proven = 1;
+	int i, k;
+
+	reserve_pool(p, workers, g);
+	find_components(g, c);
+
+	// the time and node limits are for the graph as a whole
+	atomic_store(&p->stop, 0);
+	atomic_store(&p->nodes, 0);
+	clock_gettime(CLOCK_MONOTONIC, &p->start);
+
+	if (c->n_components == 1)
+	{
+		solve_component(g, p, workers);
+		return;
+	}
+
+	for (k = 0; k < c->n_components; k++)
+	{
+		extract_component(g, c, k);
+		build_neighbourhoods(&c->part);
+		solve_component(&c->part, p, workers);
+
+		size += p->best.size;
+		lower += p->lower;
+		proven = proven && p->proven;
+		for (i = 0; i < c->part.n; i++)
+		{
+			c->dom[c->order[c->start[k] + i]] = p->best.dom[i];
+		}
+	}
+
+	p->g = g;
+	atomic_store(&p->best.size, size);
+	for (i = 0; i < g->n; i++)
+	{
+		p->best.dom[i] = c->dom[i];
+	}
+	p->lower = lower;
+	p->proven = proven;
+}
+
+/*
+ * Labels the connected components of a graph and groups its vertices by component
+ */
+void find_components(struct graph* g, struct components* c)
+{
+	int i, j, k, v, head, tail;
+
+	for (i = 0; i < g->n; i++)
+	{
+		c->comp[i] = -1;
+	}
+
+	// breadth-first search from each vertex not reached yet, with order as the queue
+	c->n_components = 0;
+	for (i = 0; i < g->n; i++)
+	{
+		if (c->comp[i] >= 0)
+		{
+			continue;
+		}
+		k = c->n_components++;
+		c->comp[i] = k;
+		c->order[0] = i;
+		head = 0;
+		tail = 1;
+		while (head < tail)
+		{
+			v = c->order[head++];
+			for (j = 0; j < g->degree[v]; j++)
+			{
+				if (c->comp[g->G[v][j]] < 0)
+				{
+					c->comp[g->G[v][j]] = k;
+					c->order[tail++] = g->G[v][j];
+				}
+			}
+		}
+	}
+
+	// a vertex's number within its component is the number of vertices of the component before it
+	for (k = 0; k <= c->n_components; k++)
+	{
+		c->start[k] = 0;
+	}
+	for (i = 0; i < g->n; i++)
+	{
+		c->local[i] = c->start[c->comp[i] + 1]++;
+	}
+	for (k = 0; k < c->n_components; k++)
+	{
+		c->start[k + 1] += c->start[k];
+	}
+	for (i = 0; i < g->n; i++)
+	{
+		c->order[c->start[c->comp[i]] + c->local[i]] = i;
+	}
+}
+
+/*
+ * Copies component k of a graph into c->part, renumbering its vertices
+ */
+void extract_component(struct graph* g, struct components* c, int k)
+{
+	struct graph* part = &c->part;
+	int i, j, v, n_adj = 0;
+
+	part->num = g->num;
+	part->n = c->start[k + 1] - c->start[k];
+	for (i = 0; i < part->n; i++)
+	{
+		n_adj += g->degree[c->order[c->start[k] + i]] + 1;
+	}
+
+	reserve_graph(part, part->n, n_adj, 1);
+	for (i = 0; i < part->n; i++)
+	{
+		part->degree[i] = g->degree[c->order[c->start[k] + i]];
+	}
+	link_rows(part);
+
+	for (i = 0; i < part->n; i++)
+	{
+		v = c->order[c->start[k] + i];
+		for (j = 0; j < g->degree[v]; j++)
+		{
+			part->G[i][j] = c->local[g->G[v][j]];
+		}
+		part->G[i][part->degree[i]] = i;
+	}
+}
+
+/*
+ * Finds a minimum dominating set of a connected graph, or of a component, with the given workers
+ */
+void solve_component(struct graph* g, struct pool* p, struct search* workers[])
+{
+	struct task root;
+	int n_workers = p->opt->n_workers;
+	int i;
+
+	p->g = g;
+	p->n_workers = n_workers;
+	select_search(p, g);
+	reserve_pool(p, workers, g);
+
+	// a few tasks per worker keep all of them busy while the shared minimum is still large
+	p->split_level = 0;
+	if (n_workers > 1)
+	{
+		for (i = 1; i < n_workers; i *= 2)
+		{
+			p->split_level++;
+		}
+		p->split_level += 4;
+	}
+	if (p->split_level > SPLIT_MAX)
+	{
+		p->split_level = SPLIT_MAX;
+	}
+
+	// the whole vertex set is always a dominating set, a warm start usually gives a much smaller one
+	if (p->opt->warm_start)
+	{
+		greedy_dom_set(g, &p->warm);
+		improve_dom_set(g, &p->warm);
+		atomic_store(&p->best.size, p->warm.size);
+		for (i = 0; i < g->n; i++)
+		{
+			p->best.dom[i] = p->warm.in_set[i];
+		}
+	}
+	else
+	{
+		atomic_store(&p->best.size, g->n);
+		for (i = 0; i < g->n; i++)
+		{
+			p->best.dom[i] = 1;
+		}
+	}
+
+	p->lower = root_lower_bound(g, &p->warm);
+	reduce_graph(g, &p->reduce, p->opt->reduce);
+	break_symmetry(g, p);
+
+	// nothing is left to search if the first set already meets the lower bound
+	if (p->best.size <= p->lower)
+	{
+		p->lower = p->best.size;
+		p->proven = 1;
+		return;
+	}
+
+	atomic_store(&p->pending, 0);
+	atomic_store(&p->queued, 0);
+	for (i = 0; i < n_workers; i++)
+	{
+		p->deques[i].head = 0;
+		p->deques[i].tail = 0;
+	}
+
+	root.n_decisions = 0;
+	push_task(p, 0, &root);
+
+	for (i = 1; i < n_workers; i++)
+	{
+		pthread_create(&workers[i]->thread, NULL, worker, workers[i]);
+	}
+	worker(workers[0]);
+	for (i = 1; i < n_workers; i++)
+	{
+		pthread_join(workers[i]->thread, NULL);
+	}
+
+	// a finished search proves the minimum optimal
+	p->proven = !atomic_load(&p->stop);
+	if (p->proven)
+	{
+		p->lower = p->best.size;
+	}
+}
+
+/*
+ * Allocates the state of n_workers workers sharing pool p
+ * Returns 0 on success
+ */
+int init_pool(struct pool* p, struct search* workers[], struct options* opt)
+{
+	int i;
+
+	p->opt = opt;
+	pthread_mutex_init(&p->best.lock, NULL);
+	pthread_mutex_init(&p->idle_lock, NULL);
+	pthread_cond_init(&p->idle, NULL);
+	for (i = 0; i < opt->n_workers; i++)
+	{
+		workers[i] = calloc(1, sizeof(struct search));
+		if (workers[i] == NULL)
+		{
+			return EXIT_FAILURE;
+		}
+		workers[i]->pool = p;
+		workers[i]->id = i;
+
+		pthread_mutex_init(&p->deques[i].lock, NULL);
+		p->deques[i].capacity = 2 * SPLIT_MAX;
+		p->deques[i].tasks = malloc(p->deques[i].capacity * sizeof(struct task));
+		if (p->deques[i].tasks == NULL)
+		{
+			return EXIT_FAILURE;
+		}
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Makes room in the pool and its workers for searching graph g
+ * Arrays only grow, so a stream of graphs of similar size is allocated once
+ */
+void reserve_pool(struct pool* p, struct search* workers[], struct graph* g)
+{
+	struct heuristic* h = &p->warm;
+	struct search* s;
+	int n = g->n;
+	int n_adj = 0; // entries in the closed adjacency lists, a bound on the size of an undo stack
+	int i;
+
+	for (i = 0; i < n; i++)
+	{
+		n_adj += g->degree[i] + 1;
+	}
+
+	if (n > p->n_cap)
+	{
+		p->best.dom = resize_array(p->best.dom, n, sizeof(int));
+		h->in_set = resize_array(h->in_set, n, sizeof(int));
+		h->count = resize_array(h->count, n, sizeof(int));
+		h->cov = resize_array(h->cov, n, sizeof(int));
+		h->next = resize_array(h->next, n, sizeof(int));
+		p->reduce.fixed = resize_array(p->reduce.fixed, n, sizeof(char));
+		p->reduce.covered = resize_array(p->reduce.covered, n, sizeof(char));
+		p->reduce.ignored = resize_array(p->reduce.ignored, n, sizeof(char));
+		p->reduce.n_cand = resize_array(p->reduce.n_cand, n, sizeof(int));
+		p->reduce.queue = resize_array(p->reduce.queue, n, sizeof(int));
+		p->reduce.queued = resize_array(p->reduce.queued, n, sizeof(char));
+		p->reduce.mark = resize_array(p->reduce.mark, n, sizeof(int));
+		p->reduce.seen = resize_array(p->reduce.seen, n, sizeof(int));
+		p->parts.comp = resize_array(p->parts.comp, n, sizeof(int));
+		p->parts.start = resize_array(p->parts.start, n + 1, sizeof(int));
+		p->parts.order = resize_array(p->parts.order, n, sizeof(int));
+		p->parts.local = resize_array(p->parts.local, n, sizeof(int));
+		p->parts.dom = resize_array(p->parts.dom, n, sizeof(int));
+	}
+	if (g->delta > p->delta_cap || h->head == NULL)
+	{
+		h->head = resize_array(h->head, g->delta + 2, sizeof(int));
+		h->mdd_count = resize_array(h->mdd_count, g->delta + 2, sizeof(int));
+	}
+
+	for (i = 0; i < p->opt->n_workers; i++)
+	{
+		s = workers[i];
+		if (n > p->n_cap)
+		{
+			s->dominated = resize_array(s->dominated, (n + 63) / 64, sizeof(uint64_t));
+			s->num_choice = resize_array(s->num_choice, n, sizeof(int));
+			s->dom = resize_array(s->dom, n, sizeof(int));
+			s->blue = resize_array(s->blue, n, sizeof(int));
+			s->choice_next = resize_array(s->choice_next, n, sizeof(int));
+			s->choice_prev = resize_array(s->choice_prev, n, sizeof(int));
+			s->trail = resize_array(s->trail, n, sizeof(struct decision));
+		}
+		if (n_adj > p->adj_cap)
+		{
+			s->undo = resize_array(s->undo, n_adj, sizeof(uint64_t));
+		}
+		if (g->delta > p->delta_cap || s->choice_head == NULL)
+		{
+			s->choice_head = resize_array(s->choice_head, g->delta + 2, sizeof(int));
+		}
+	}
+
+	if (n > p->n_cap)
+	{
+		p->n_cap = n;
+	}
+	if (n_adj > p->adj_cap)
+	{
+		p->adj_cap = n_adj;
+	}
+	if (g->delta > p->delta_cap)
+	{
+		p->delta_cap = g->delta;
+	}
+}
+
+/*
+ * Frees the state allocated by init_pool and reserve_pool
+ */
+void free_pool(struct pool* p, struct search* workers[])
+{
+	struct heuristic* h = &p->warm;
+	struct search* s;
+	int i;
+
+	for (i = 0; i < p->opt->n_workers; i++)
+	{
+		s = workers[i];
+		free(s->dominated);
+		free(s->num_choice);
+		free(s->dom);
+		free(s->blue);
+		free(s->choice_head);
+		free(s->choice_next);
+		free(s->choice_prev);
+		free(s->trail);
+		free(s->undo);
+		free(p->deques[i].tasks);
+		free(s);
+	}
+	free(p->best.dom);
+	free(h->in_set);
+	free(h->count);
+	free(h->cov);
+	free(h->head);
+	free(h->next);
+	free(h->mdd_count);
+	free(p->reduce.fixed);
+	free(p->reduce.covered);
+	free(p->reduce.ignored);
+	free(p->reduce.n_cand);
+	free(p->reduce.queue);
+	free(p->reduce.queued);
+	free(p->reduce.mark);
+	free(p->reduce.seen);
+	free(p->parts.comp);
+	free(p->parts.start);
+	free(p->parts.order);
+	free(p->parts.local);
+	free(p->parts.dom);
+	free_graph(&p->parts.part);
+	free(p->sym.moved);
+	free(p->sym.moved_start);
+	free_automorphisms(&p->sym.aut);
+}
+
+/*
+ * Frees the arrays of a graph
+ */
+void free_graph(struct graph* g)
+{
+	free(g->degree);
+	free(g->G);
+	free(g->nb_count);
+	free(g->nb_word);
+	free(g->nb_mask);
+	free(g->adj_buf);
+	free(g->nb_word_all);
+	free(g->nb_mask_all);
+	free(g->gens);
+}
+
+/*
+ * Reads graphs into the slots of the ring as they become free
+ */
+void* batch_reader(void* arg)
+{
+	struct batch* b = arg;
+	struct slot* slot;
+
+	for (;;)
+	{
+		// wait until the slot of the next graph has been printed
+		pthread_mutex_lock(&b->lock);
+		while (b->n_read - b->n_printed == b->n_slots)
+		{
+			pthread_cond_wait(&b->changed, &b->lock);
+		}
+		slot = &b->slots[b->n_read % b->n_slots];
+		pthread_mutex_unlock(&b->lock);
+
+		// only the reader touches an empty slot
+		int status = read_graph(slot->g, b->src);
+
+		pthread_mutex_lock(&b->lock);
+		if (status == 0)
+		{
+			slot->state = SLOT_READ;
+			b->n_read++;
+		}
+		else
+		{
+			b->eof = 1;
+		}
+		pthread_cond_broadcast(&b->changed);
+		pthread_mutex_unlock(&b->lock);
+
+		if (status != 0)
+		{
+			return NULL;
+		}
+	}
+}
+
+/*
+ * Searches graphs in the order they were read until the reader reaches the end of the input
+ */
+void* batch_solver(void* arg)
+{
+	struct batch* b = arg;
+	struct pool* p;
+	struct search* workers[THREAD_MAX];
+	struct slot* slot;
+	int i;
+
+	p = calloc(1, sizeof(struct pool));
+	if (p == NULL || init_pool(p, workers, b->opt) != 0)
+	{
+		printf("Not enough memory for the workers\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (;;)
+	{
+		pthread_mutex_lock(&b->lock);
+		while (b->n_taken == b->n_read && !b->eof)
+		{
+			pthread_cond_wait(&b->changed, &b->lock);
+		}
+		if (b->n_taken == b->n_read)
+		{
+			pthread_mutex_unlock(&b->lock);
+			break;
+		}
+		slot = &b->slots[b->n_taken % b->n_slots];
+		b->n_taken++;
+		pthread_mutex_unlock(&b->lock);
+
+		build_neighbourhoods(slot->g);
+		solve(slot->g, p, workers);
+
+		slot->min_size = p->best.size;
+		slot->lower = p->lower;
+		slot->proven = p->proven;
+		if (slot->g->n > slot->n_cap)
+		{
+			slot->min_dom = resize_array(slot->min_dom, slot->g->n, sizeof(int));
+			slot->n_cap = slot->g->n;
+		}
+		for (i = 0; i < slot->g->n; i++)
+		{
+			slot->min_dom[i] = p->best.dom[i];
+		}
+
+		pthread_mutex_lock(&b->lock);
+		slot->state = SLOT_SOLVED;
+		pthread_cond_broadcast(&b->changed);
+		pthread_mutex_unlock(&b->lock);
+	}
+
+	free_pool(p, workers);
+	free(p);
+	return NULL;
+}
+
+/*
+ * Searches n_solvers graphs at a time and prints the results in input order
+ */
+int run_batch(struct options* opt, struct source* src)
+{
+	int n_solvers = opt->n_solvers;
+	struct batch b;
+	pthread_t reader;
+	pthread_t solvers[THREAD_MAX];
+	struct slot* slot;
+	int i;
+
+	pthread_mutex_init(&b.lock, NULL);
+	pthread_cond_init(&b.changed, NULL);
+	b.n_slots = SLOTS_PER_SOLVER * n_solvers;
+	b.n_read = 0;
+	b.n_taken = 0;
+	b.n_printed = 0;
+	b.eof = 0;
+	b.opt = opt;
+	b.src = src;
+
+	b.slots = malloc(b.n_slots * sizeof(struct slot));
+	if (b.slots == NULL)
+	{
+		printf("Not enough memory for the batch\n");
+		return EXIT_FAILURE;
+	}
+	for (i = 0; i < b.n_slots; i++)
+	{
+		b.slots[i].state = SLOT_EMPTY;
+		b.slots[i].min_dom = NULL;
+		b.slots[i].n_cap = 0;
+		b.slots[i].g = calloc(1, sizeof(struct graph));
+		if (b.slots[i].g == NULL)
+		{
+			printf("Not enough memory for the batch\n");
+			return EXIT_FAILURE;
+		}
+	}
+
+	pthread_create(&reader, NULL, batch_reader, &b);
+	for (i = 0; i < n_solvers; i++)
+	{
+		pthread_create(&solvers[i], NULL, batch_solver, &b);
+	}
+
+	// prints the results in input order
+	for (;;)
+	{
+		pthread_mutex_lock(&b.lock);
+		slot = &b.slots[b.n_printed % b.n_slots];
+		while (!(b.n_printed < b.n_read && slot->state == SLOT_SOLVED) && !(b.eof && b.n_printed == b.n_read))
+		{
+			pthread_cond_wait(&b.changed, &b.lock);
+		}
+		if (b.n_printed == b.n_read)
+		{
+			pthread_mutex_unlock(&b.lock);
+			break;
+		}
+		pthread_mutex_unlock(&b.lock);
+
+		print_result(opt, slot->g->num, slot->g, slot->min_size, slot->min_dom, slot->lower, slot->proven);
+
+		pthread_mutex_lock(&b.lock);
+		slot->state = SLOT_EMPTY;
+		b.n_printed++;
+		pthread_cond_broadcast(&b.changed);
+		pthread_mutex_unlock(&b.lock);
+	}
+
+	pthread_join(reader, NULL);
+	for (i = 0; i < n_solvers; i++)
+	{
+		pthread_join(solvers[i], NULL);
+	}
+
+	for (i = 0; i < b.n_slots; i++)
+	{
+		free_graph(b.slots[i].g);
+		free(b.slots[i].g);
+		free(b.slots[i].min_dom);
+	}
+	free(b.slots);
+
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Prints contents of an array in debug mode
+ */
+void print_vector(int size, int arr[])
+{
+	int i;
+	for (i = 0; i < size; i++)
+	{
+		printf("%d: %d\n", i, arr[i]);
+	}
+	printf("\n");
+}
+
+/*
+ * Prints a minimum dominating set order followed by a minimum dominating set in verbose output mode
+ */
+void print_verbose_min_dom_set(struct out_writer* out, int min_size, int n, int min_dom[])
+{
+	out_int(out, min_size);
+	out_char(out, '\n');
+
+	int i;
+	for (i = 0; i < n; i++)
+	{
+		if (min_dom[i] == 1)
+		{
+			out_int(out, i);
+			out_char(out, ' ');
+		}
+	}
+	out_str(out, "\n\n");
+}
+
+/*
+ * Prints graph number, number of vertices, and a minimum dominating set order in terse output mode
+ */
+void print_nonverbose_min_dom_set(struct out_writer* out, int graph_num, int n, int min_size)
+{
+	out_int_width(out, graph_num, 5);
+	out_char(out, ' ');
+	out_int_width(out, n, 3);
+	out_char(out, ' ');
+	out_int_width(out, min_size, 3);
+	out_char(out, '\n');
+}
+
+/*
+ * Prints graph number, number of vertices, a dominating set order, a lower bound on the minimum order,
+ * and whether the order is proven optimal in terse output mode with a time or node limit
+ */
+void print_anytime_min_dom_set(struct out_writer* out, int graph_num, int n, int min_size, int lower, int proven)
+{
+	out_int_width(out, graph_num, 5);
+	out_char(out, ' ');
+	out_int_width(out, n, 3);
+	out_char(out, ' ');
+	out_int_width(out, min_size, 3);
+	out_char(out, ' ');
+	out_int_width(out, lower, 3);
+	out_str(out, proven ? " optimal\n" : " not proven\n");
+}
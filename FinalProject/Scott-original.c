@@ -9,33 +9,31 @@
 
 #include <stdio.h> 
 #include <stdlib.h>
+#include "../common/adjacency.h"
 
-// maximum number of vertices
-#define NMAX 2187
-// maximum degree
-#define DEG_MAX 16
 #define DEBUG 0
 
-int read_graph(int* n, int degree[NMAX], int G[NMAX][DEG_MAX]); 
-void print_graph(int n, int degree[NMAX], int G[NMAX][DEG_MAX]);
-void min_dom_set(int level, int* n, int degree[NMAX], int G[NMAX][DEG_MAX], int* n_dominated, int num_dominated[NMAX],
-				int num_choice[NMAX], int* size, int dom[NMAX], int* min_size, int min_dom[NMAX]);
+void print_graph(int n, int degree[], int* G[]);
+void min_dom_set(int level, int* n, int degree[], int* G[], int* n_dominated, int num_dominated[],
+				int num_choice[], int* size, int dom[], int* min_size, int min_dom[]);
 void print_vector(int size, int arr[]);
 void print_verbose_min_dom_set(int min_size, int n, int min_dom[]);
 void print_nonverbose_min_dom_set(int graph_num, int n, int min_size);
 
 int main(int argc, char *argv[])
 {
+	static struct adjacency a; // adjacency lists of the current graph
 	int n; // number of vertices
-	int degree[NMAX]; // degrees of vertices
-	int G[NMAX][DEG_MAX]; // adjacency list
+	int* degree; // degrees of vertices
+	int** G; // adjacency list
 	int n_dominated; // number of dominated vertices
-	int num_dominated[NMAX]; // number of times a vertex is dominated
-	int num_choice[NMAX]; // number of times a vertex could be dominated if all white vertices were red
+	int* num_dominated = NULL; // number of times a vertex is dominated
+	int* num_choice = NULL; // number of times a vertex could be dominated if all white vertices were red
 	int size; // number of vertices added to dominating set
-	int dom[NMAX]; // vertices added to dominating set
+	int* dom = NULL; // vertices added to dominating set
 	int min_size; // minimum number of vertices in dominating set
-	int min_dom[NMAX]; // vertices added to minimum dominating set
+	int* min_dom = NULL; // vertices added to minimum dominating set
+	int n_cap = 0; // vertices the arrays above have room for
 	int verbose; // user-specified verbosity level, 0 for terse, 1 for verbose
 	int graph_num = 0; // graph number
 	
@@ -50,8 +48,22 @@ int main(int argc, char *argv[])
 	verbose = atoi(argv[1]);
 
 	// Processes input    
-    while (read_graph(&n, degree, G) == 0)
+    while (read_adjacency(&a) == 0)
     {
+		n = a.n;
+		degree = a.degree;
+		G = a.G;
+
+		// The arrays only grow, so graphs of similar size reuse them
+		if (n > n_cap)
+		{
+			num_dominated = resize_array(num_dominated, n, sizeof(int));
+			num_choice = resize_array(num_choice, n, sizeof(int));
+			dom = resize_array(dom, n, sizeof(int));
+			min_dom = resize_array(min_dom, n, sizeof(int));
+			n_cap = n;
+		}
+
 		// Increments the number of graph
 		graph_num++;
         // If verbose output selected, prints graph, finds and prints minimum dominating set
@@ -68,54 +80,20 @@ int main(int argc, char *argv[])
 			print_nonverbose_min_dom_set(graph_num, n, min_size);
         }
     }
+
+	free(num_dominated);
+	free(num_choice);
+	free(dom);
+	free(min_dom);
+	free_adjacency(&a);
 	
 	return EXIT_SUCCESS;
 }
 
-/*
- * Reads in a graph from standard input
- */
-int read_graph(int* n, int degree[NMAX], int G[NMAX][DEG_MAX]) 
-{
-    // Reads in input as long as end of file is not reached
-	if (fscanf(stdin, "%d", n) == 1)
-	{
-		int i, j;
-
-		// For each vertex
-		for (i = 0; i < *n; i++)
-		{
-			// Reads in its degree
-			if (scanf("%d", &degree[i]) != 1)
-			{
-				return EXIT_FAILURE;
-			}
-
-			if (degree[i] >= DEG_MAX)
-			{
-				printf("A vertex degree cannot be equal to or greater than %d", DEG_MAX);
-				return EXIT_FAILURE;
-			}
-
-			// For each degree
-			for (j = 0; j < degree[i]; j++)
-			{
-				// Reads in the vertex's neighbours
-				if (scanf("%d", &G[i][j]) != 1)
-				{
-					return EXIT_FAILURE;
-				}
-			}
-		}
-        return EXIT_SUCCESS;
-	}
-    return EXIT_FAILURE;
-}
-
 /*
  * Prints graph in verbose output mode
  */
-void print_graph(int n, int degree[NMAX], int G[NMAX][DEG_MAX])
+void print_graph(int n, int degree[], int* G[])
 {
 	int i, j;
 	
@@ -136,8 +114,8 @@ void print_graph(int n, int degree[NMAX], int G[NMAX][DEG_MAX])
  * Finds a minimum dominating set of a graph
  * Coluring: red = in dominating set, blue = excluded from dominating set, white = undecided
  */
-void min_dom_set(int level, int* n, int degree[NMAX], int G[NMAX][DEG_MAX], int* n_dominated, int num_dominated[NMAX],
-				int num_choice[NMAX], int* size, int dom[NMAX], int* min_size, int min_dom[NMAX])
+void min_dom_set(int level, int* n, int degree[], int* G[], int* n_dominated, int num_dominated[],
+				int num_choice[], int* size, int dom[], int* min_size, int min_dom[])
 {
 
 #if DEBUG
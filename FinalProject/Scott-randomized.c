@@ -5,42 +5,106 @@
  * Output: goes out to standard output
  * 		   If verbosity is set to 1, graph followed by a dominating set
  *         If verbosity is set to 0, graph number, number of vertices, dominating set order
+ * Options: --portfolio k  race k random vertex orderings on k threads, each with its own seeded
+ *                         generator; the first ordering to finish its search proves the order
+ *                         optimal and stops the others. Per-ordering statistics go to standard error
+ *          --seed s       base seed of the portfolio generators (default 1), so that runs repeat
+ *          --flush        flush the output after every graph, so results survive the program being
+ *                         killed by a CPU limit; otherwise output is buffered and written in large blocks
+ * Compile: gcc -O2 -pthread Scott-randomized.c
+ *
+ * Without --portfolio, one ordering per graph is drawn from rand() as before. The orderings of a
+ * portfolio share one minimum dominating set, so a good set found by any of them prunes all the others.
  */
 
 #include <stdio.h> 
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include "../common/adjacency.h"
+#include "../common/out_writer.h"
 
-// maximum number of vertices
-#define NMAX 2187
-// maximum degree
-#define DEG_MAX 16
+// maximum number of orderings in a portfolio
+#define PORTFOLIO_MAX 256
 #define DEBUG 0
 
-int read_graph(int* n, int degree[NMAX], int G[NMAX][DEG_MAX]); 
-void print_graph(int n, int degree[NMAX], int G[NMAX][DEG_MAX]);
-void min_dom_set(int level, int delta, int n, int degree[NMAX], int G[NMAX][DEG_MAX], int* n_dominated, int num_dominated[NMAX],
-				 int num_choice[NMAX], int* size, int dom[NMAX], int* min_size, int min_dom[NMAX], int rand_arr[NMAX]);
-void print_vector(int size, int arr[]);
-void print_verbose_min_dom_set(int min_size, int n, int min_dom[]);
-void print_nonverbose_min_dom_set(int graph_num, int n, int min_size);
-void randomize_vertices(int n, int rand_arr[NMAX]);
+/*
+ * PCG32 generator (O'Neill, https://www.pcg-random.org): 64-bit state, one stream per ordering
+ */
+struct pcg32
+{
+	uint64_t state;
+	uint64_t inc; // odd increment that selects the stream
+};
 
-int main(int argc, char *argv[])
+/*
+ * Search state of one vertex ordering
+ */
+struct ordering
 {
-	int n; // number of vertices
-	int degree[NMAX]; // degrees of vertices
-	int G[NMAX][DEG_MAX]; // adjacency list
+	int* rand_arr; // vertices in the order they are considered
 	int n_dominated; // number of dominated vertices
-	int num_dominated[NMAX]; // number of times a vertex is dominated
-	int num_choice[NMAX]; // number of times a vertex could be dominated if all white vertices were red
+	int* num_dominated; // number of times a vertex is dominated
+	int* num_choice; // number of times a vertex could be dominated if all white vertices were red
 	int size; // number of vertices added to dominating set
-	int dom[NMAX]; // vertices added to dominating set
-	int min_size; // minimum number of vertices in dominating set
-	int min_dom[NMAX]; // vertices added to minimum dominating set
+	int* dom; // vertices added to dominating set
+	int n_cap; // vertices the arrays above have room for
+	struct pcg32 rng; // generator of the ordering, unused without a portfolio
+	long long nodes; // number of search nodes visited
+	int best; // order of the smallest dominating set this ordering found, 0 if none
+	int stopped; // 1 if another ordering finished first
+	double time; // seconds spent searching
+	struct portfolio* p; // shared state of the portfolio
+	int id; // index of the ordering in the portfolio
+	pthread_t thread;
+};
+
+/*
+ * State shared by all orderings searching the current graph
+ */
+struct portfolio
+{
+	int n; // number of vertices
+	int delta; // maximum degree of a vertex
+	int* degree; // degrees of vertices
+	int** G; // adjacency list, closed: G[i][degree[i]] == i
+	atomic_int min_size; // minimum number of vertices in dominating set
+	pthread_mutex_t lock; // guards min_dom
+	int* min_dom; // vertices added to minimum dominating set
+	int n_cap; // vertices min_dom has room for
+	atomic_int done; // 1 once an ordering has finished its search
+	int winner; // index of the ordering that finished first
+};
+
+void print_graph(struct out_writer* out, int n, int degree[], int* G[]);
+void init_portfolio(struct portfolio* p, int n, int degree[], int* G[]);
+void init_ordering(struct ordering* o, struct portfolio* p);
+void min_dom_set(int level, struct ordering* o);
+void* search_ordering(void* arg);
+void print_vector(int size, int arr[]);
+void print_verbose_min_dom_set(struct out_writer* out, int min_size, int n, int min_dom[]);
+void print_nonverbose_min_dom_set(struct out_writer* out, int graph_num, int n, int min_size);
+void print_ordering_stats(int graph_num, uint64_t seed, int n_orderings, struct ordering* orderings[]);
+void randomize_vertices(int n, int rand_arr[], struct pcg32* rng);
+void pcg32_seed(struct pcg32* rng, uint64_t seed, uint64_t stream);
+uint32_t pcg32_next(struct pcg32* rng);
+uint32_t pcg32_bounded(struct pcg32* rng, uint32_t bound);
+
+int main(int argc, char *argv[])
+{
+	static struct adjacency a; // adjacency lists of the current graph
+	static struct portfolio p; // state shared by the orderings
+	struct ordering* orderings[PORTFOLIO_MAX]; // search state of each ordering
+	int n_orderings = 0; // user-specified number of orderings, 0 for a single rand() ordering
+	uint64_t seed = 1; // user-specified base seed of the portfolio
 	int verbose; // user-specified verbosity level, 0 for terse, 1 for verbose
+	int flush = 0; // 1 to flush the output after every graph
+	static struct out_writer out; // buffered standard output
 	int graph_num = 0; // graph number
-	int delta = 0; // maximum degree of a vertex in a graph
-	int rand_arr[NMAX]; // vertices in a graph
+	int i;
 	
 	// prints error message if incorrect usage
 	if (argc < 2)
@@ -51,37 +115,168 @@ int main(int argc, char *argv[])
 
     // reads in the user-specified verbosity level
 	verbose = atoi(argv[1]);
+
+	// reads in the options
+	for (i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--portfolio") == 0 && i + 1 < argc)
+		{
+			n_orderings = atoi(argv[++i]);
+			if (n_orderings < 1 || n_orderings > PORTFOLIO_MAX)
+			{
+				printf("The number of orderings must be between 1 and %d\n", PORTFOLIO_MAX);
+				return EXIT_FAILURE;
+			}
+		}
+		else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			seed = strtoull(argv[++i], NULL, 10);
+		}
+		else if (strcmp(argv[i], "--flush") == 0)
+		{
+			flush = 1;
+		}
+		else
+		{
+			printf("Unknown option %s\nOptions: --portfolio k, --seed s, --flush\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (out_open(&out, stdout, flush) != 0)
+	{
+		printf("Not enough memory for the output\n");
+		return EXIT_FAILURE;
+	}
+
+	for (i = 0; i < (n_orderings > 0 ? n_orderings : 1); i++)
+	{
+		orderings[i] = calloc(1, sizeof(struct ordering));
+		if (orderings[i] == NULL)
+		{
+			printf("Out of memory\n");
+			return EXIT_FAILURE;
+		}
+		orderings[i]->id = i;
+		// every ordering draws from its own stream, seeded once so that a run can be repeated
+		pcg32_seed(&orderings[i]->rng, seed, i);
+	}
+	pthread_mutex_init(&p.lock, NULL);
 	
 	// processes input    
-    while (read_graph(&n, degree, G) == 0)
+    while (read_adjacency(&a) == 0)
     {
 		// increments the number of graph
 		graph_num++;
-		// randomizes the order in which vertices are considered
-		randomize_vertices(n, rand_arr);
+		init_portfolio(&p, a.n, a.degree, a.G);
+
+		if (verbose == 1)
+		{
+			print_graph(&out, a.n, a.degree, a.G);
+		}
+
+		if (n_orderings == 0)
+		{
+			// randomizes the order in which vertices are considered
+			init_ordering(orderings[0], &p);
+			randomize_vertices(a.n, orderings[0]->rand_arr, NULL);
+			min_dom_set(0, orderings[0]);
+		}
+		else
+		{
+			for (i = 0; i < n_orderings; i++)
+			{
+				init_ordering(orderings[i], &p);
+				randomize_vertices(a.n, orderings[i]->rand_arr, &orderings[i]->rng);
+				pthread_create(&orderings[i]->thread, NULL, search_ordering, orderings[i]);
+			}
+			for (i = 0; i < n_orderings; i++)
+			{
+				pthread_join(orderings[i]->thread, NULL);
+			}
+		}
 		
-        // if verbose output selected, print graph, find and print minimum dominating set
+        // if verbose output selected, print minimum dominating set
 		if (verbose == 1)
 		{
-			print_graph(n, degree, G);
-			min_dom_set(0, delta, n, degree, G, &n_dominated, num_dominated, num_choice, &size, dom, &min_size, min_dom, rand_arr);
-			print_verbose_min_dom_set(min_size, n, min_dom);
+			print_verbose_min_dom_set(&out, atomic_load(&p.min_size), a.n, p.min_dom);
 		}
-		// if terse output selected, print graph number and number of vertices, find and print minimum dominating set order
+		// if terse output selected, print graph number and number of vertices, and minimum dominating set order
         else
         {
-			min_dom_set(0, delta, n, degree, G, &n_dominated, num_dominated, num_choice, &size, dom, &min_size, min_dom, rand_arr);
-			print_nonverbose_min_dom_set(graph_num, n, min_size);
+			print_nonverbose_min_dom_set(&out, graph_num, a.n, atomic_load(&p.min_size));
         }
+		out_flush(&out);
+		out_end_record(&out);
+
+		if (n_orderings > 0)
+		{
+			print_ordering_stats(graph_num, seed, n_orderings, orderings);
+		}
     }
+
+	for (i = 0; i < (n_orderings > 0 ? n_orderings : 1); i++)
+	{
+		free(orderings[i]->rand_arr);
+		free(orderings[i]->num_dominated);
+		free(orderings[i]->num_choice);
+		free(orderings[i]->dom);
+		free(orderings[i]);
+	}
+	free(p.min_dom);
+	free_adjacency(&a);
+	out_close(&out);
+	pthread_mutex_destroy(&p.lock);
 	
 	return EXIT_SUCCESS;
 }
 
 /*
- * Randomizes the order of vertices in a graph
+ * Seeds a generator; generators with the same seed and different streams give independent sequences
+ */
+void pcg32_seed(struct pcg32* rng, uint64_t seed, uint64_t stream)
+{
+	rng->state = 0;
+	rng->inc = (stream << 1) | 1;
+	pcg32_next(rng);
+	rng->state += seed;
+	pcg32_next(rng);
+}
+
+/*
+ * Returns the next 32-bit output of a generator
  */
-void randomize_vertices(int n, int rand_arr[NMAX])
+uint32_t pcg32_next(struct pcg32* rng)
+{
+	uint64_t old = rng->state;
+	uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+	uint32_t rot = (uint32_t)(old >> 59);
+
+	rng->state = old * 6364136223846793005ULL + rng->inc;
+	return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+}
+
+/*
+ * Returns a uniformly distributed value in [0, bound)
+ */
+uint32_t pcg32_bounded(struct pcg32* rng, uint32_t bound)
+{
+	// reject the low values that would make some results more likely than others
+	uint32_t threshold = -bound % bound;
+	uint32_t r;
+
+	do
+	{
+		r = pcg32_next(rng);
+	} while (r < threshold);
+
+	return r % bound;
+}
+
+/*
+ * Randomizes the order of vertices in a graph, drawing from rng, or from rand() if rng is NULL
+ */
+void randomize_vertices(int n, int rand_arr[], struct pcg32* rng)
 {
 	int i, j, k;	
 	// populate rand_arr with the vertices in current graph
@@ -94,7 +289,14 @@ void randomize_vertices(int n, int rand_arr[NMAX])
 	// https://benpfaff.org/writings/clc/shuffle.html
 	for (i = 0; i < n - 1; i++) 
 	{
-        j = i + rand() / (RAND_MAX / (n - i) + 1);
+        if (rng == NULL)
+        {
+            j = i + rand() / (RAND_MAX / (n - i) + 1);
+        }
+        else
+        {
+            j = i + (int)pcg32_bounded(rng, (uint32_t)(n - i));
+        }
         k = rand_arr[j];
         rand_arr[j] = rand_arr[i];
         rand_arr[i] = k;
@@ -102,190 +304,229 @@ void randomize_vertices(int n, int rand_arr[NMAX])
 }
 
 /*
- * Reads in a graph from standard input
+ * Prints graph in verbose output mode
  */
-int read_graph(int* n, int degree[NMAX], int G[NMAX][DEG_MAX]) 
+void print_graph(struct out_writer* out, int n, int degree[], int* G[])
 {
-    // reads in input as long as end of file is not reached
-	if (fscanf(stdin, "%d", n) == 1)
+	int i, j;
+	
+	out_int(out, n);
+	out_char(out, '\n');
+
+	for (i = 0; i < n; i++)
 	{
-		int i, j;
+		out_int(out, degree[i]);
+		out_char(out, ' ');
+		for (j = 0; j < degree[i]; j++)
+		{			
+			out_int(out, G[i][j]);
+			out_char(out, ' ');
+		}
+		out_char(out, '\n');
+	}
+}
 
-		// for each vertex
-		for (i = 0; i < *n; i++)
-		{
-			// read in its degree
-			if (scanf("%d", &degree[i]) != 1)
-			{
-				return EXIT_FAILURE;
-			}
+/*
+ * Closes the adjacency lists of the current graph and resets the shared minimum
+ */
+void init_portfolio(struct portfolio* p, int n, int degree[], int* G[])
+{
+	int i;
 
-			if (degree[i] >= DEG_MAX)
-			{
-				printf("A vertex degree cannot be equal to or greater than %d", DEG_MAX);
-				return EXIT_FAILURE;
-			}
+	p->n = n;
+	p->degree = degree;
+	p->G = G;
+	p->delta = degree[0]; // maximum degree of a vertex
+	atomic_store(&p->min_size, n);
+	atomic_store(&p->done, 0);
+	p->winner = -1;
 
-			// for each degree
-			for (j = 0; j < degree[i]; j++)
-			{
-				// read in the vertex's neighbours
-				if (scanf("%d", &G[i][j]) != 1)
-				{
-					return EXIT_FAILURE;
-				}
-			}
+	// the arrays only grow, so graphs of similar size reuse them
+	if (n > p->n_cap)
+	{
+		p->min_dom = resize_array(p->min_dom, n, sizeof(int));
+		p->n_cap = n;
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		p->min_dom[i] = i;
+		// add vertex to list of own neighbours, before any ordering starts reading G
+		G[i][degree[i]] = i;
+		// find the maximum degree in a graph
+		if (degree[i] > p->delta)
+		{
+			p->delta = degree[i];
 		}
-        return EXIT_SUCCESS;
 	}
-    return EXIT_FAILURE;
 }
 
 /*
- * Prints graph in verbose output mode
+ * Initializes the search state of an ordering for the current graph
  */
-void print_graph(int n, int degree[NMAX], int G[NMAX][DEG_MAX])
+void init_ordering(struct ordering* o, struct portfolio* p)
 {
-	int i, j;
-	
-	printf("%d\n", n);
+	int i;
 
-	for (i = 0; i < n; i++)
+	o->p = p;
+	o->n_dominated = 0;
+	o->size = 0;
+	o->nodes = 0;
+	o->best = 0;
+	o->stopped = 0;
+
+	if (p->n > o->n_cap)
 	{
-		printf("%d ", degree[i]);
-		for (j = 0; j < degree[i]; j++)
-		{			
-			printf("%d ", G[i][j]);
-		}
-		printf("\n");
+		o->rand_arr = resize_array(o->rand_arr, p->n, sizeof(int));
+		o->num_dominated = resize_array(o->num_dominated, p->n, sizeof(int));
+		o->num_choice = resize_array(o->num_choice, p->n, sizeof(int));
+		o->dom = resize_array(o->dom, p->n, sizeof(int));
+		o->n_cap = p->n;
+	}
+
+	for (i = 0; i < p->n; i++)
+	{
+		o->num_choice[i] = p->degree[i] + 1;
+		o->num_dominated[i] = 0;
+		o->dom[i] = 0;
+	}
+}
+
+/*
+ * Searches the current graph in one ordering of a portfolio; the first to finish stops the others
+ */
+void* search_ordering(void* arg)
+{
+	struct ordering* o = arg;
+	struct timespec start, end;
+	int expected = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	min_dom_set(0, o);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	o->time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+	// a search that ran to the end against the shared minimum has proven it optimal
+	if (!o->stopped && atomic_compare_exchange_strong(&o->p->done, &expected, 1))
+	{
+		o->p->winner = o->id;
 	}
+	return NULL;
 }
 
 /*
  * Finds a minimum dominating set of a graph
  * Coluring: red = in dominating set, blue = excluded from dominating set, white = undecided
  */
-void min_dom_set(int level, int delta, int n, int degree[NMAX], int G[NMAX][DEG_MAX], int* n_dominated, int num_dominated[NMAX],
-				 int num_choice[NMAX], int* size, int dom[NMAX], int* min_size, int min_dom[NMAX], int rand_arr[NMAX])
+void min_dom_set(int level, struct ordering* o)
 {
+	struct portfolio* p = o->p;
+	int n = p->n;
+	int* degree = p->degree;
+	int** G = p->G;
 	int i;
 
-	// initialize data structures
-	// level is the vertex currently under consideration
-	if (level == 0)
+	o->nodes++;
+
+	// another ordering has already proven its minimum optimal
+	if (atomic_load_explicit(&p->done, memory_order_relaxed))
 	{
-		*n_dominated = 0;		
-		*size = 0;
-		// no values assigned to dom[]
-		*min_size = n;		
-        delta = degree[0]; // maximum degree of a vertex
-		
-		for (i = 0; i < n; i++)
-		{
-			num_choice[i] = degree[i] + 1;
-			num_dominated[i] = 0;
-			min_dom[i] = i;
-			// add vertex to list of own neighbours
-			G[i][degree[i]] = i;
-			// find the maximum degree in a graph
-            if (degree[i] > delta)
-            {
-                delta = degree[i];
-            }
-		}
+		o->stopped = 1;
+		return;
 	}
 
 	#if DEBUG
 	printf("\nLevel %3d: \n", level);
 	printf("Current dominating set:\n");
-	print_vector(*size, dom);
-	printf("Minimum dominating set:\n");
-	print_vector(*min_size, min_dom);
-	printf("Number of vertices dominated: %3d\n", *n_dominated);
+	print_vector(o->size, o->dom);
+	printf("Number of vertices dominated: %3d\n", o->n_dominated);
 	printf("Number of choices per vertex:\n");
-	print_vector(n, num_choice);
+	print_vector(n, o->num_choice);
 	printf("Number of times dominated:\n");
-	print_vector(n, num_dominated);
-	printf("Size is: %d, min_size is: %d\n", *size, *min_size);
+	print_vector(n, o->num_dominated);
+	printf("Size is: %d, min_size is: %d\n", o->size, atomic_load(&p->min_size));
 	#endif
 	
 	// backtrack
 	for (i = 0; i < n; i++)
 	{
-		if (num_choice[i] == 0)
+		if (o->num_choice[i] == 0)
 		{
 			return;
 		}
 	}
 
-	int u = n - *n_dominated; // number of undominated vertices
+	int u = n - o->n_dominated; // number of undominated vertices
 
-	int n_extra = (u + delta)/(delta + 1);
+	int n_extra = (u + p->delta)/(p->delta + 1);
 	
-	if (*size + n_extra >= *min_size)
+	if (o->size + n_extra >= atomic_load_explicit(&p->min_size, memory_order_relaxed))
 	{
 		return;
 	}
 
-	if (level == n || *n_dominated == n)
+	if (level == n || o->n_dominated == n)
 	{
-		if (*size < *min_size)
+		pthread_mutex_lock(&p->lock);
+		if (o->size < atomic_load(&p->min_size))
 		{
 			for (i = 0; i < n; i++)
 			{
-				min_dom[i] = dom[i];
+				p->min_dom[i] = o->dom[i];
 			}
-			*min_size = *size;
+			atomic_store(&p->min_size, o->size);
+			o->best = o->size;
 		}
+		pthread_mutex_unlock(&p->lock);
 		return;
 	}
 
 	// exhaustive backtrack
-	u = rand_arr[level];
+	u = o->rand_arr[level];
 	
 	// try colouring a vertex blue
 	for (i = 0; i <= degree[u]; i++)
 	{
-		num_choice[G[u][i]]--;
+		o->num_choice[G[u][i]]--;
 	}
 
 	// recursive call
-	min_dom_set(level + 1, delta, n, degree, G, n_dominated, num_dominated, num_choice, size, dom, min_size, min_dom, rand_arr);
+	min_dom_set(level + 1, o);
 
 	// undo colouring a vertex blue (colour it white)
 	for (i = 0; i <= degree[u]; i++)
 	{
-		num_choice[G[u][i]]++;
+		o->num_choice[G[u][i]]++;
 	}
 	
 	// try colouring a vertex red
-	dom[u] = 1;
-	(*size)++;
+	o->dom[u] = 1;
+	o->size++;
 
 	for (i = 0; i <= degree[u]; i++)
 	{
-		num_dominated[G[u][i]]++;
+		o->num_dominated[G[u][i]]++;
 		// increase number of dominated vertices
-		if (num_dominated[G[u][i]] == 1)
+		if (o->num_dominated[G[u][i]] == 1)
 		{
-			(*n_dominated)++;
+			o->n_dominated++;
 		}
 	}
 	
 	// recursive call
-	min_dom_set(level + 1, delta, n, degree, G, n_dominated, num_dominated, num_choice, size, dom, min_size, min_dom, rand_arr);
+	min_dom_set(level + 1, o);
 
 	// undo colouring a vertex red (colour it white)
-	dom[u] = 0;
-	(*size)--;	
+	o->dom[u] = 0;
+	o->size--;	
 
 	for (i = 0; i <= degree[u]; i++)
 	{
-		num_dominated[G[u][i]]--;
+		o->num_dominated[G[u][i]]--;
 		// decrease number of dominated vertices
-		if (num_dominated[G[u][i]] == 0)
+		if (o->num_dominated[G[u][i]] == 0)
 		{
-			(*n_dominated)--;
+			o->n_dominated--;
 		}
 	}
 }
@@ -306,29 +547,57 @@ void print_vector(int size, int arr[])
 /*
  * Prints a minimum dominating set order followed by a minimum dominating set in verbose output mode
  */
-void print_verbose_min_dom_set(int min_size, int n, int min_dom[])
+void print_verbose_min_dom_set(struct out_writer* out, int min_size, int n, int min_dom[])
 {
-	printf("%d\n", min_size);
+	out_int(out, min_size);
+	out_char(out, '\n');
 
     int i;
     for (i = 0; i < n; i++) 
 	{
         if (min_dom[i] == 1) 
 		{
-            printf("%d ", i);
+            out_int(out, i);
+            out_char(out, ' ');
         }
     }
-    printf("\n\n");
-
-	fflush(stdout);
+    out_str(out, "\n\n");
 }
 
 /*
  * Prints graph number, number of vertices, and a minimum dominating set order in terse output mode
  */
-void print_nonverbose_min_dom_set(int graph_num, int n, int min_size)
+void print_nonverbose_min_dom_set(struct out_writer* out, int graph_num, int n, int min_size)
 {
-	printf("%5d %3d %3d\n", graph_num, n, min_size);
-	
-	fflush(stdout);
-}
\ No newline at end of file
+	out_int_width(out, graph_num, 5);
+	out_char(out, ' ');
+	out_int_width(out, n, 3);
+	out_char(out, ' ');
+	out_int_width(out, min_size, 3);
+	out_char(out, '\n');
+}
+
+/*
+ * Prints the statistics of each ordering of a portfolio to standard error
+ */
+void print_ordering_stats(int graph_num, uint64_t seed, int n_orderings, struct ordering* orderings[])
+{
+	int i;
+
+	for (i = 0; i < n_orderings; i++)
+	{
+		struct ordering* o = orderings[i];
+
+		fprintf(stderr, "Graph %d ordering %d (seed %llu, stream %d): %lld nodes, ", graph_num, i,
+				(unsigned long long)seed, i, o->nodes);
+		if (o->best > 0)
+		{
+			fprintf(stderr, "best %d, ", o->best);
+		}
+		else
+		{
+			fprintf(stderr, "no improvement, ");
+		}
+		fprintf(stderr, "%s, %.3f s\n", o->id == o->p->winner ? "proved optimal" : "stopped", o->time);
+	}
+}
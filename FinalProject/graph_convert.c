@@ -0,0 +1,223 @@
+/*
+ * This program converts graphs from the text format read by the solvers into a binary graph file
+ * (see common/graph_file.h) for Scott-fast.c. It checks that every neighbour is a vertex of its graph.
+ * Input: provided through standard input
+ * 		  Format: number of vertices, degree of each vertex followed by a list of its neighbours
+ * Output: the binary graph file named on the command line
+ * Options: --narrow  store neighbours in 16 bits when a graph has at most 65536 vertices, which
+ *                    halves the file but makes the solvers copy each graph out of it
+ * Compile: gcc -O2 graph_convert.c -o graph_convert
+ * Example: graph_convert in_triang_grid.bin < in_triang_grid.txt
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../common/int_reader.h"
+#include "../common/graph_file.h"
+
+int convert_graph(FILE* out, uint64_t* pos, int graph_num, int narrow, struct graph_file_entry* entry);
+int write_padded(FILE* out, uint64_t* pos, const void* data, size_t len);
+
+int main(int argc, char *argv[])
+{
+	FILE* out; // binary graph file
+	struct graph_file_header header; // header of the file
+	struct graph_file_entry* index = NULL; // index entry of each graph
+	int n_graphs = 0; // number of graphs converted
+	int capacity = 0; // number of entries index has room for
+	uint64_t pos = 0; // bytes written so far
+	int narrow = 0; // 1 to store neighbours in 16 bits where they fit
+	const char* name; // name of the binary graph file
+	int status;
+
+	// reads in the options
+	if (argc > 1 && strcmp(argv[1], "--narrow") == 0)
+	{
+		narrow = 1;
+		argv++;
+		argc--;
+	}
+
+	// prints error message if incorrect usage
+	if (argc < 2)
+	{
+		printf("Must specify the output file\nExample: graph_convert [--narrow] in.bin < in.txt\n");
+		return EXIT_FAILURE;
+	}
+	name = argv[1];
+
+	out = fopen(name, "wb");
+	if (out == NULL)
+	{
+		printf("Cannot open %s\n", name);
+		return EXIT_FAILURE;
+	}
+
+	// the header is written again once the number of graphs and the index offset are known
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, GRAPH_FILE_MAGIC, 8);
+	header.version = GRAPH_FILE_VERSION;
+	if (write_padded(out, &pos, &header, sizeof(header)) != 0)
+	{
+		printf("Cannot write %s\n", name);
+		return EXIT_FAILURE;
+	}
+
+	for (;;)
+	{
+		if (n_graphs == capacity)
+		{
+			capacity = capacity > 0 ? 2 * capacity : 1024;
+			index = realloc(index, capacity * sizeof(struct graph_file_entry));
+			if (index == NULL)
+			{
+				printf("Out of memory\n");
+				return EXIT_FAILURE;
+			}
+		}
+
+		status = convert_graph(out, &pos, n_graphs + 1, narrow, &index[n_graphs]);
+		if (status == EOF)
+		{
+			break;
+		}
+		if (status != 0)
+		{
+			fclose(out);
+			remove(name);
+			return EXIT_FAILURE;
+		}
+		n_graphs++;
+	}
+
+	header.n_graphs = (uint32_t)n_graphs;
+	header.index_offset = pos;
+	if (write_padded(out, &pos, index, n_graphs * sizeof(struct graph_file_entry)) != 0
+		|| fseek(out, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, out) != 1 || fclose(out) != 0)
+	{
+		printf("Cannot write %s\n", name);
+		return EXIT_FAILURE;
+	}
+
+	free(index);
+	printf("%d graphs written to %s\n", n_graphs, name);
+
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Reads in one graph from standard input and appends it to the file, each row closed with the vertex itself
+ * Returns 0 on success, EOF at the end of input, 1 on bad input or a failed write
+ */
+int convert_graph(FILE* out, uint64_t* pos, int graph_num, int narrow, struct graph_file_entry* entry)
+{
+	static uint32_t* offsets = NULL; // offsets array of the graph
+	static uint32_t* adj = NULL; // adjacency array of the graph
+	static size_t offsets_cap = 0, adj_cap = 0;
+	int n, degree, v, i, j;
+	uint32_t n_adj = 0;
+
+	if (read_int(&n) != 1)
+	{
+		return EOF;
+	}
+	if (n < 1)
+	{
+		printf("Invalid input.\nGraph %d: the number of vertices must be >= 1.\n", graph_num);
+		return 1;
+	}
+
+	if ((size_t)n + 1 > offsets_cap)
+	{
+		offsets_cap = (size_t)n + 1;
+		offsets = realloc(offsets, offsets_cap * sizeof(uint32_t));
+		if (offsets == NULL)
+		{
+			printf("Out of memory\n");
+			return 1;
+		}
+	}
+
+	// for each vertex
+	for (i = 0; i < n; i++)
+	{
+		offsets[i] = n_adj;
+
+		// read in its degree
+		if (read_int(&degree) != 1 || degree < 0 || degree > n - 1)
+		{
+			printf("Invalid input.\nGraph %d: the degree of vertex %d must be between 0 and %d.\n", graph_num, i, n - 1);
+			return 1;
+		}
+
+		if (n_adj + (size_t)degree + 1 > adj_cap)
+		{
+			adj_cap = 2 * (n_adj + (size_t)degree + 1);
+			adj = realloc(adj, adj_cap * sizeof(uint32_t));
+			if (adj == NULL)
+			{
+				printf("Out of memory\n");
+				return 1;
+			}
+		}
+
+		// read in the vertex's neighbours
+		for (j = 0; j < degree; j++)
+		{
+			if (read_int(&v) != 1 || v < 0 || v > n - 1)
+			{
+				printf("Invalid input.\nGraph %d: a neighbour of vertex %d must be between 0 and %d.\n", graph_num, i, n - 1);
+				return 1;
+			}
+			adj[n_adj++] = (uint32_t)v;
+		}
+		adj[n_adj++] = (uint32_t)i;
+	}
+	offsets[n] = n_adj;
+
+	entry->offset = *pos;
+	entry->n = (uint32_t)n;
+	entry->n_adj = n_adj;
+	entry->width = narrow && n <= 65536 ? 2 : 4;
+	entry->reserved = 0;
+
+	if (write_padded(out, pos, offsets, ((size_t)n + 1) * sizeof(uint32_t)) != 0)
+	{
+		printf("Cannot write graph %d\n", graph_num);
+		return 1;
+	}
+
+	// narrow the neighbours in place when they fit in 16 bits
+	if (entry->width == 2)
+	{
+		for (j = 0; j < (int)n_adj; j++)
+		{
+			uint16_t narrow = (uint16_t)adj[j];
+			memcpy((char*)adj + 2 * (size_t)j, &narrow, 2);
+		}
+	}
+	if (write_padded(out, pos, adj, (size_t)n_adj * entry->width) != 0)
+	{
+		printf("Cannot write graph %d\n", graph_num);
+		return 1;
+	}
+
+	return 0;
+}
+
+/*
+ * Writes len bytes followed by zeros up to the next multiple of 8; returns 0 on success
+ */
+int write_padded(FILE* out, uint64_t* pos, const void* data, size_t len)
+{
+	static const char zeros[8] = { 0 };
+	size_t pad = (8 - len % 8) % 8;
+
+	if ((len > 0 && fwrite(data, 1, len, out) != len) || (pad > 0 && fwrite(zeros, 1, pad, out) != pad))
+	{
+		return 1;
+	}
+	*pos += len + pad;
+	return 0;
+}
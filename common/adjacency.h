@@ -0,0 +1,120 @@
+/*
+ * Adjacency lists sized at run time, shared by the solvers that keep a graph as G[i][j]
+ * The lists of all vertices are stored back to back in one array, so a graph takes O(n + m) memory
+ * whatever its order and maximum degree. The arrays only grow, so reading a stream of graphs of
+ * similar size allocates once.
+ *
+ * Usage: #include "../common/adjacency.h", then read graphs with read_adjacency(&a) and use
+ * a.n, a.degree[i] and a.G[i][j] as before
+ */
+
+#ifndef ADJACENCY_H
+#define ADJACENCY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "int_reader.h"
+
+struct adjacency
+{
+	int n; // number of vertices
+	int* degree; // degrees of vertices
+	int** G; // adjacency list; G[i] has room for one more entry after its neighbours, for i itself
+	int* adj; // the rows of G back to back, degree[i] + 1 entries for vertex i
+	int n_cap; // vertices degree and G have room for
+	int adj_cap; // entries adj has room for
+};
+
+/*
+ * Resizes an array to count elements of the given size, exiting if there is not enough memory
+ */
+static inline void* resize_array(void* arr, size_t count, size_t size)
+{
+	arr = realloc(arr, count * size);
+	if (arr == NULL && count > 0)
+	{
+		printf("Not enough memory for the graph\n");
+		exit(EXIT_FAILURE);
+	}
+	return arr;
+}
+
+/*
+ * Reads in a graph from standard input
+ * Returns EXIT_FAILURE at the end of input, on truncated input, or if a neighbour is not a vertex
+ */
+static inline int read_adjacency(struct adjacency* a)
+{
+	int i, j, start = 0;
+
+	// reads in input as long as end of file is not reached
+	if (read_int(&a->n) != 1 || a->n < 1)
+	{
+		return EXIT_FAILURE;
+	}
+
+	if (a->n > a->n_cap)
+	{
+		a->degree = resize_array(a->degree, a->n, sizeof(int));
+		a->G = resize_array(a->G, a->n, sizeof(int*));
+		a->n_cap = a->n;
+	}
+
+	// for each vertex
+	for (i = 0; i < a->n; i++)
+	{
+		// read in its degree
+		if (read_int(&a->degree[i]) != 1 || a->degree[i] < 0)
+		{
+			return EXIT_FAILURE;
+		}
+
+		// the number of edges is only known at the end, so adj grows geometrically
+		if (start + a->degree[i] + 1 > a->adj_cap)
+		{
+			a->adj_cap = start + a->degree[i] + 1 > 2 * a->adj_cap ? start + a->degree[i] + 1 : 2 * a->adj_cap;
+			a->adj = resize_array(a->adj, a->adj_cap, sizeof(int));
+		}
+
+		// read in the vertex's neighbours
+		for (j = 0; j < a->degree[i]; j++)
+		{
+			if (read_int(&a->adj[start + j]) != 1)
+			{
+				return EXIT_FAILURE;
+			}
+			if (a->adj[start + j] < 0 || a->adj[start + j] >= a->n)
+			{
+				printf("A neighbour must be between 0 and %d", a->n - 1);
+				return EXIT_FAILURE;
+			}
+		}
+		start += a->degree[i] + 1;
+	}
+
+	// adj no longer moves, so the rows can point into it
+	start = 0;
+	for (i = 0; i < a->n; i++)
+	{
+		a->G[i] = a->adj + start;
+		start += a->degree[i] + 1;
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+ * Frees the arrays of a graph
+ */
+static inline void free_adjacency(struct adjacency* a)
+{
+	free(a->degree);
+	free(a->G);
+	free(a->adj);
+	a->degree = NULL;
+	a->G = NULL;
+	a->adj = NULL;
+	a->n_cap = 0;
+	a->adj_cap = 0;
+}
+
+#endif
@@ -0,0 +1,410 @@
+/*
+ * Automorphism group of a graph, as a list of generating permutations
+ * The search follows the usual individualization-refinement scheme. Base points are fixed one at a
+ * time, and at each level an automorphism is looked for that maps the base point to each vertex of
+ * its cell not yet in its orbit. The generators found at a level fix the base points before it, so
+ * together they generate the whole group when the search finishes within its budget.
+ *
+ * Both sides of a candidate mapping are refined together as one colouring of two copies of the graph.
+ * A vertex's new colour hashes its old colour with the colours of its neighbours. A collision can only
+ * hide an automorphism, because every candidate is checked against the edges before it is kept.
+ *
+ * Usage: #include "../common/automorphism.h", then
+ *        find_automorphisms(&a, n, degree, G, budget) leaves the generators in a.gens
+ */
+
+#ifndef AUTOMORPHISM_H
+#define AUTOMORPHISM_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Vertex with its colour, for matching the two copies once every colour picks out one vertex
+ */
+struct aut_pair
+{
+	uint64_t colour;
+	int vertex;
+};
+
+/*
+ * Generators of an automorphism group, and the scratch space used to find them
+ */
+struct automorphisms
+{
+	int n; // number of vertices
+	int n_gens; // number of generators
+	size_t gens_cap; // entries gens has room for
+	int* gens; // generator k maps vertex i to gens[k * n + i]
+	int n_cap; // vertices the scratch space has room for
+	uint64_t* colour; // colouring of the two copies at the current base level, 2n entries
+	uint64_t* sorted; // colours of one copy in increasing order
+	uint64_t* other; // colours of the other copy in increasing order
+	struct aut_pair* pairs; // vertices of both copies, sorted by colour within each copy
+	int* perm; // candidate automorphism
+	int* mark; // stamp of the neighbours of a vertex, when checking a candidate
+	int* orbit; // vertices of the orbit of the current base point, as a queue
+	char* in_orbit; // 1 for vertices in that orbit
+	long long budget; // work left, in vertex visits
+};
+
+/*
+ * Resizes an array to count elements of the given size; returns NULL if there is not enough memory
+ */
+static inline void* aut_resize(void* arr, size_t count, size_t size)
+{
+	void* p = realloc(arr, count * size);
+	return p == NULL && count > 0 ? NULL : p;
+}
+
+/*
+ * Mixes the bits of a 64-bit value (splitmix64 finalizer)
+ */
+static inline uint64_t aut_mix(uint64_t x)
+{
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ULL;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebULL;
+	x ^= x >> 31;
+	return x;
+}
+
+static inline int aut_cmp(const void* a, const void* b)
+{
+	uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+	return (x > y) - (x < y);
+}
+
+static inline int aut_pair_cmp(const void* a, const void* b)
+{
+	return aut_cmp(&((const struct aut_pair*)a)->colour, &((const struct aut_pair*)b)->colour);
+}
+
+/*
+ * Sorts the colours of both copies into a->sorted and a->other; returns the number of cells of the
+ * first copy, or 0 if the copies do not have the same number of vertices of each colour
+ */
+static inline int aut_cells(struct automorphisms* a, const uint64_t col[])
+{
+	int n = a->n, i, cells = 0;
+
+	memcpy(a->sorted, col, n * sizeof(uint64_t));
+	memcpy(a->other, col + n, n * sizeof(uint64_t));
+	qsort(a->sorted, n, sizeof(uint64_t), aut_cmp);
+	qsort(a->other, n, sizeof(uint64_t), aut_cmp);
+	a->budget -= 2 * (long long)n;
+
+	for (i = 0; i < n; i++)
+	{
+		if (a->sorted[i] != a->other[i])
+		{
+			return 0;
+		}
+		if (i == 0 || a->sorted[i] != a->sorted[i - 1])
+		{
+			cells++;
+		}
+	}
+	return cells;
+}
+
+/*
+ * Refines the colouring of both copies until it is stable; returns the number of cells of the first
+ * copy, or 0 if the copies stop matching
+ */
+static inline int aut_refine(struct automorphisms* a, const int degree[], int* const G[], uint64_t col[], uint64_t next[])
+{
+	int n = a->n, v, j, x, side, cells, refined;
+	uint64_t sum;
+
+	cells = aut_cells(a, col);
+	while (cells > 0 && cells < n && a->budget > 0)
+	{
+		for (v = 0; v < 2 * n; v++)
+		{
+			side = v < n ? 0 : n;
+			x = v - side;
+			sum = 0;
+			for (j = 0; j < degree[x]; j++)
+			{
+				sum += aut_mix(col[G[x][j] + side]);
+			}
+			next[v] = aut_mix(col[v] ^ (sum * 0x9e3779b97f4a7c15ULL));
+			a->budget -= degree[x] + 1;
+		}
+		memcpy(col, next, 2 * n * sizeof(uint64_t));
+
+		// the new colouring refines the old one, so the partition is stable once no cell splits
+		refined = aut_cells(a, col);
+		if (refined == cells)
+		{
+			break;
+		}
+		cells = refined;
+	}
+	return cells;
+}
+
+/*
+ * Returns 1 if a->perm maps every edge of the graph onto an edge
+ */
+static inline int aut_check(struct automorphisms* a, const int degree[], int* const G[])
+{
+	int v, j;
+
+	for (v = 0; v < a->n; v++)
+	{
+		a->mark[v] = -1;
+	}
+	for (v = 0; v < a->n; v++)
+	{
+		if (degree[v] != degree[a->perm[v]])
+		{
+			return 0;
+		}
+		for (j = 0; j < degree[a->perm[v]]; j++)
+		{
+			a->mark[G[a->perm[v]][j]] = v;
+		}
+		for (j = 0; j < degree[v]; j++)
+		{
+			if (a->mark[a->perm[G[v][j]]] != v)
+			{
+				return 0;
+			}
+		}
+	}
+	a->budget -= a->n;
+	return 1;
+}
+
+/*
+ * Looks for an automorphism consistent with the colouring of the two copies; returns 1 and leaves
+ * it in a->perm if one is found
+ */
+static inline int aut_search(struct automorphisms* a, const int degree[], int* const G[], const uint64_t col[])
+{
+	int n = a->n, v, w, target, found = 0;
+	uint64_t cell = 0, best = 0;
+	uint64_t* c;
+	uint64_t* next;
+	int cells, size, best_size = n + 1, i;
+
+	if (a->budget <= 0)
+	{
+		return 0;
+	}
+
+	c = malloc(4 * n * sizeof(uint64_t));
+	if (c == NULL)
+	{
+		return 0;
+	}
+	next = c + 2 * n;
+	memcpy(c, col, 2 * n * sizeof(uint64_t));
+
+	cells = aut_refine(a, degree, G, c, next);
+	if (cells == 0 || a->budget <= 0)
+	{
+		free(c);
+		return 0;
+	}
+
+	if (cells == n)
+	{
+		// every colour picks out one vertex of each copy
+		for (v = 0; v < 2 * n; v++)
+		{
+			a->pairs[v].colour = c[v];
+			a->pairs[v].vertex = v < n ? v : v - n;
+		}
+		qsort(a->pairs, n, sizeof(struct aut_pair), aut_pair_cmp);
+		qsort(a->pairs + n, n, sizeof(struct aut_pair), aut_pair_cmp);
+		for (i = 0; i < n; i++)
+		{
+			a->perm[a->pairs[i].vertex] = a->pairs[n + i].vertex;
+		}
+		found = aut_check(a, degree, G);
+		free(c);
+		return found;
+	}
+
+	// branch on the smallest cell that is not a single vertex
+	for (i = 0; i < n; i += size)
+	{
+		for (size = 1; i + size < n && a->sorted[i + size] == a->sorted[i]; size++)
+		{
+		}
+		if (size > 1 && size < best_size)
+		{
+			best_size = size;
+			best = a->sorted[i];
+		}
+	}
+	for (target = 0; c[target] != best; target++)
+	{
+	}
+
+	for (w = 0; w < n && !found; w++)
+	{
+		if (c[n + w] == best)
+		{
+			cell = aut_mix(best ^ 0x5851f42d4c957f2dULL);
+			memcpy(next, c, 2 * n * sizeof(uint64_t));
+			next[target] = cell;
+			next[n + w] = cell;
+			found = aut_search(a, degree, G, next);
+		}
+	}
+	free(c);
+	return found;
+}
+
+/*
+ * Marks the orbit of vertex b under generators first to a->n_gens - 1 in a->in_orbit
+ */
+static inline void aut_orbit(struct automorphisms* a, int b, int first)
+{
+	int head = 0, tail = 1, k, v, w;
+
+	memset(a->in_orbit, 0, a->n);
+	a->in_orbit[b] = 1;
+	a->orbit[0] = b;
+	while (head < tail)
+	{
+		v = a->orbit[head++];
+		for (k = first; k < a->n_gens; k++)
+		{
+			w = a->gens[(size_t)k * a->n + v];
+			if (!a->in_orbit[w])
+			{
+				a->in_orbit[w] = 1;
+				a->orbit[tail++] = w;
+			}
+		}
+	}
+}
+
+/*
+ * Finds generators of the automorphism group of a graph, spending about budget vertex visits
+ * Returns 0 on success, 1 if the budget ran out (the generators found so far still generate a
+ * subgroup), -1 if there is not enough memory
+ */
+static inline int find_automorphisms(struct automorphisms* a, int n, const int degree[], int* const G[], long long budget)
+{
+	uint64_t* next;
+	uint64_t base;
+	int cells, size, best_size, first, b, w, i;
+
+	a->n = n;
+	a->n_gens = 0;
+	a->budget = budget;
+
+	if (n > a->n_cap)
+	{
+		a->colour = aut_resize(a->colour, 4 * (size_t)n, sizeof(uint64_t));
+		a->sorted = aut_resize(a->sorted, n, sizeof(uint64_t));
+		a->other = aut_resize(a->other, n, sizeof(uint64_t));
+		a->pairs = aut_resize(a->pairs, 2 * (size_t)n, sizeof(struct aut_pair));
+		a->perm = aut_resize(a->perm, n, sizeof(int));
+		a->mark = aut_resize(a->mark, n, sizeof(int));
+		a->orbit = aut_resize(a->orbit, n, sizeof(int));
+		a->in_orbit = aut_resize(a->in_orbit, n, sizeof(char));
+		if (a->colour == NULL || a->sorted == NULL || a->other == NULL || a->pairs == NULL || a->perm == NULL || a->mark == NULL
+			|| a->orbit == NULL || a->in_orbit == NULL)
+		{
+			a->n_cap = 0;
+			return -1;
+		}
+		a->n_cap = n;
+	}
+	next = a->colour + 2 * n;
+
+	// both copies start with one colour, and stay identical along the base
+	memset(a->colour, 0, 2 * n * sizeof(uint64_t));
+	for (;;)
+	{
+		cells = aut_refine(a, degree, G, a->colour, next);
+		if (cells == n || a->budget <= 0)
+		{
+			break;
+		}
+
+		// the next base point is the first vertex of the smallest cell that is not a single vertex
+		best_size = n + 1;
+		base = 0;
+		for (i = 0; i < n; i += size)
+		{
+			for (size = 1; i + size < n && a->sorted[i + size] == a->sorted[i]; size++)
+			{
+			}
+			if (size > 1 && size < best_size)
+			{
+				best_size = size;
+				base = a->sorted[i];
+			}
+		}
+		for (b = 0; a->colour[b] != base; b++)
+		{
+		}
+
+		// map b to every vertex of its cell that the generators of this level cannot reach yet
+		first = a->n_gens;
+		aut_orbit(a, b, first);
+		for (w = b + 1; w < n && a->budget > 0; w++)
+		{
+			if (a->colour[w] != base || a->in_orbit[w])
+			{
+				continue;
+			}
+			memcpy(next, a->colour, 2 * n * sizeof(uint64_t));
+			next[b] = aut_mix(base ^ 0x5851f42d4c957f2dULL);
+			next[n + w] = next[b];
+			if (aut_search(a, degree, G, next))
+			{
+				if ((size_t)(a->n_gens + 1) * n > a->gens_cap)
+				{
+					a->gens_cap = 2 * (size_t)(a->n_gens + 1) * n;
+					a->gens = aut_resize(a->gens, a->gens_cap, sizeof(int));
+					if (a->gens == NULL)
+					{
+						a->gens_cap = 0;
+						a->n_gens = 0;
+						return -1;
+					}
+				}
+				memcpy(a->gens + (size_t)a->n_gens * n, a->perm, n * sizeof(int));
+				a->n_gens++;
+				aut_orbit(a, b, first);
+			}
+		}
+
+		// fix b in both copies and go down one level
+		a->colour[b] = aut_mix(base ^ 0x5851f42d4c957f2dULL);
+		a->colour[n + b] = a->colour[b];
+	}
+	return a->budget > 0 ? 0 : 1;
+}
+
+/*
+ * Frees the generators and scratch space
+ */
+static inline void free_automorphisms(struct automorphisms* a)
+{
+	free(a->gens);
+	free(a->colour);
+	free(a->sorted);
+	free(a->other);
+	free(a->pairs);
+	free(a->perm);
+	free(a->mark);
+	free(a->orbit);
+	free(a->in_orbit);
+	memset(a, 0, sizeof(*a));
+}
+
+#endif
@@ -0,0 +1,253 @@
+/*
+ * Binary graph file: a stream of graphs stored as CSR adjacency behind an index of per-graph offsets,
+ * so a program can memory-map the file and go straight to graph k without reading the graphs before it.
+ * A file coming through a pipe cannot be mapped, so it is read into memory whole instead.
+ * Files are written by FinalProject/graph_convert.c from the text format read by the solvers.
+ *
+ * Layout, in the byte order of the machine that wrote the file, every section starting on an 8-byte
+ * boundary (a file is only read back on a machine of the same byte order):
+ *   header  magic "DOMCSR01", uint32 version, uint32 number of graphs, uint64 offset of the index
+ *   graphs  for each graph: uint32 offsets[n + 1], where the closed neighbourhood of vertex i is
+ *           entries offsets[i] to offsets[i + 1] - 1 of the adjacency array, its neighbours and then
+ *           i itself, followed by the adjacency array as uint32, or as uint16 in a narrow file
+ *   index   for each graph: uint64 offset of its offsets array, uint32 n, uint32 number of adjacency
+ *           entries (the sum of the degrees plus n), uint32 bytes per neighbour, uint32 reserved
+ *
+ * Rows of uint32 entries are laid out as the solvers keep a graph in memory, so they are searched
+ * where they lie in the mapping without being copied. Narrow rows take half the space but have to
+ * be widened as they are loaded.
+ *
+ * Usage: #include "../common/graph_file.h"
+ */
+
+#ifndef GRAPH_FILE_H
+#define GRAPH_FILE_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define GRAPH_FILE_MAGIC "DOMCSR01"
+#define GRAPH_FILE_VERSION 2
+
+struct graph_file_header
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t n_graphs;
+	uint64_t index_offset;
+};
+
+struct graph_file_entry
+{
+	uint64_t offset; // offset of the graph's offsets array
+	uint32_t n; // number of vertices
+	uint32_t n_adj; // number of adjacency entries, the sum of the degrees plus n
+	uint32_t width; // bytes per neighbour, 2 or 4
+	uint32_t reserved;
+};
+
+/*
+ * Binary graph file, mapped or read into memory
+ */
+struct graph_file
+{
+	const unsigned char* data; // the whole file
+	size_t len; // length of the file
+	int mapped; // 1 if data is a mapping of the file, 0 if it was read into memory
+	int n_graphs; // number of graphs in the file
+	const struct graph_file_entry* index; // one entry per graph
+};
+
+/*
+ * One graph of a binary graph file; the arrays point into the mapping
+ */
+struct csr_graph
+{
+	int n; // number of vertices
+	int n_adj; // number of adjacency entries
+	int width; // bytes per neighbour, 2 or 4
+	const uint32_t* offsets; // N[i] is adjacency entries offsets[i] to offsets[i + 1] - 1, i last
+	const void* adj; // adjacency array of uint16_t or uint32_t
+};
+
+/*
+ * Checks the header of the len bytes of a binary graph file at data and points gf at its index;
+ * returns 0 on success, -1 if the file is damaged
+ */
+static inline int graph_file_attach(struct graph_file* gf, const unsigned char* data, size_t len)
+{
+	struct graph_file_header header;
+
+	memcpy(&header, data, sizeof(header));
+	if (header.version != GRAPH_FILE_VERSION || header.index_offset % 8 != 0 || header.index_offset > len
+		|| (len - header.index_offset) / sizeof(struct graph_file_entry) < header.n_graphs
+		|| header.n_graphs > INT32_MAX)
+	{
+		return -1;
+	}
+
+	gf->data = data;
+	gf->len = len;
+	gf->n_graphs = (int)header.n_graphs;
+	gf->index = (const struct graph_file_entry*)(gf->data + header.index_offset);
+	return 0;
+}
+
+/*
+ * Maps fd if it holds a binary graph file; returns 0 if it does, 1 if it does not (for example
+ * text input or a pipe), -1 if it is a binary graph file that is damaged
+ * The file position of fd is left untouched, so text input can still be read from it.
+ */
+static inline int graph_file_open(struct graph_file* gf, int fd)
+{
+	struct stat st;
+	struct graph_file_header header;
+	void* map;
+
+	memset(gf, 0, sizeof(*gf));
+
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || (size_t)st.st_size < sizeof(header)
+		|| pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)
+		|| memcmp(header.magic, GRAPH_FILE_MAGIC, 8) != 0)
+	{
+		return 1;
+	}
+
+	map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (map == MAP_FAILED)
+	{
+		return -1;
+	}
+	gf->mapped = 1;
+	if (graph_file_attach(gf, map, (size_t)st.st_size) != 0)
+	{
+		munmap(map, (size_t)st.st_size);
+		gf->mapped = 0;
+		return -1;
+	}
+	return 0;
+}
+
+/*
+ * Reads a binary graph file that cannot be mapped, such as one coming through a pipe, into memory:
+ * the n_head bytes at head, which have already been read from fd, then the rest of fd
+ * Returns 0 on success, -1 if the file is damaged or there is not enough memory
+ */
+static inline int graph_file_read(struct graph_file* gf, int fd, const char* head, size_t n_head)
+{
+	unsigned char* data;
+	size_t len = n_head, cap = n_head > (1 << 20) ? 2 * n_head : (1 << 20);
+	ssize_t got;
+
+	memset(gf, 0, sizeof(*gf));
+	data = malloc(cap);
+	if (data == NULL)
+	{
+		return -1;
+	}
+	memcpy(data, head, n_head);
+
+	for (;;)
+	{
+		if (len == cap)
+		{
+			unsigned char* grown = realloc(data, 2 * cap);
+			if (grown == NULL)
+			{
+				free(data);
+				return -1;
+			}
+			data = grown;
+			cap *= 2;
+		}
+		got = read(fd, data + len, cap - len);
+		if (got < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (got <= 0)
+		{
+			break;
+		}
+		len += (size_t)got;
+	}
+
+	if (len < sizeof(struct graph_file_header) || memcmp(data, GRAPH_FILE_MAGIC, 8) != 0
+		|| graph_file_attach(gf, data, len) != 0)
+	{
+		free(data);
+		return -1;
+	}
+	return 0;
+}
+
+/*
+ * Unmaps or frees a binary graph file
+ */
+static inline void graph_file_close(struct graph_file* gf)
+{
+	if (gf->data != NULL && gf->mapped)
+	{
+		munmap((void*)gf->data, gf->len);
+	}
+	else
+	{
+		free((void*)gf->data);
+	}
+	memset(gf, 0, sizeof(*gf));
+}
+
+/*
+ * Points g at graph k of the file, counting from 0; returns 0 on success, -1 if there is no
+ * graph k or its entry does not fit the file
+ */
+static inline int graph_file_get(const struct graph_file* gf, int k, struct csr_graph* g)
+{
+	const struct graph_file_entry* e;
+	uint64_t adj_offset;
+
+	if (k < 0 || k >= gf->n_graphs)
+	{
+		return -1;
+	}
+	e = &gf->index[k];
+
+	// the adjacency array starts on the 8-byte boundary after the offsets array
+	adj_offset = e->offset + ((((uint64_t)e->n + 1) * sizeof(uint32_t) + 7) & ~(uint64_t)7);
+	if (e->offset % 8 != 0 || (e->width != 2 && e->width != 4) || e->n > INT32_MAX || e->n_adj > INT32_MAX
+		|| e->offset > gf->len || adj_offset > gf->len || (gf->len - adj_offset) / e->width < e->n_adj)
+	{
+		return -1;
+	}
+
+	g->n = (int)e->n;
+	g->n_adj = (int)e->n_adj;
+	g->width = (int)e->width;
+	g->offsets = (const uint32_t*)(gf->data + e->offset);
+	g->adj = gf->data + adj_offset;
+
+	if (g->offsets[0] != 0 || g->offsets[g->n] != e->n_adj)
+	{
+		return -1;
+	}
+	return 0;
+}
+
+/*
+ * Returns adjacency entry j of a graph, unchecked, so callers compare it with n as unsigned
+ */
+static inline uint32_t csr_neighbour(const struct csr_graph* g, int j)
+{
+	if (g->width == 2)
+	{
+		return ((const uint16_t*)g->adj)[j];
+	}
+	return ((const uint32_t*)g->adj)[j];
+}
+
+#endif
@@ -0,0 +1,293 @@
+/*
+ * Fast reader of whitespace-separated integers, shared by the programs in this repository.
+ * A regular file is memory-mapped and parsed in place. Anything else, such as a pipe or a
+ * terminal, is read in large blocks.
+ * int_reader_next() and read_int() return what scanf("%d") would: 1 when an integer was read,
+ * 0 when the next token is not an integer, and EOF when only whitespace is left. Callers
+ * therefore detect truncated input exactly as before.
+ * Every byte up to and including ' ' counts as whitespace. A token of more than 10 digits, or one
+ * outside the range of int, is not an integer.
+ *
+ * Usage: #include "../common/int_reader.h", then call read_int(&x) in place of scanf("%d", &x)
+ *
+ * With SSE2 (every x86-64 compiler), the end of a whitespace run and of a digit run are each
+ * found with one 16-byte compare and movemask. The digits are then converted in a loop whose
+ * trip count is known in advance.
+ */
+
+#ifndef INT_READER_H
+#define INT_READER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// size of a block read from input that cannot be mapped
+#define INT_READER_BLOCK (1 << 20)
+// bytes kept ahead of a token in block mode, enough for any integer
+#define INT_READER_LOOKAHEAD 64
+// maximum number of digits in an int
+#define INT_READER_DIGITS_MAX 10
+
+struct int_reader
+{
+	const char* data; // input bytes
+	size_t len; // number of bytes in data
+	size_t pos; // next byte to parse
+	char* buf; // block buffer, NULL when the input is mapped
+	size_t map_len; // length of the mapping, 0 when the input is read in blocks
+	int fd; // file descriptor read from
+	int eof; // 1 once all of the input is in data
+	int open; // 1 once the reader is set up
+};
+
+/*
+ * Sets up a reader of file descriptor fd; returns 0 on success, -1 if out of memory
+ */
+static inline int int_reader_open(struct int_reader* r, int fd)
+{
+	struct stat st;
+
+	memset(r, 0, sizeof(*r));
+	r->fd = fd;
+	r->open = 1;
+
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+	{
+		void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (map != MAP_FAILED)
+		{
+			madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+			r->data = map;
+			r->len = r->map_len = (size_t)st.st_size;
+			r->eof = 1;
+			return 0;
+		}
+	}
+
+	// not a regular file, or it could not be mapped
+	r->buf = malloc(INT_READER_BLOCK);
+	if (r->buf == NULL)
+	{
+		r->eof = 1;
+		return -1;
+	}
+	r->data = r->buf;
+	return 0;
+}
+
+/*
+ * Releases the mapping or buffer of a reader
+ */
+static inline void int_reader_close(struct int_reader* r)
+{
+	if (r->map_len > 0)
+	{
+		munmap((void*)r->data, r->map_len);
+	}
+	free(r->buf);
+	memset(r, 0, sizeof(*r));
+}
+
+/*
+ * Moves the unparsed bytes to the front of the block buffer and reads more after them with one
+ * read call, so input from a pipe or terminal is parsed as soon as it arrives;
+ * returns the number of bytes added, 0 at the end of input
+ */
+static inline size_t int_reader_fill(struct int_reader* r)
+{
+	ssize_t got;
+
+	if (r->eof)
+	{
+		return 0;
+	}
+
+	memmove(r->buf, r->buf + r->pos, r->len - r->pos);
+	r->len -= r->pos;
+	r->pos = 0;
+
+	do
+	{
+		got = read(r->fd, r->buf + r->len, INT_READER_BLOCK - r->len);
+	} while (got < 0 && errno == EINTR);
+	if (got <= 0)
+	{
+		r->eof = 1;
+		return 0;
+	}
+	r->len += (size_t)got;
+	return (size_t)got;
+}
+
+/*
+ * Returns 1 if the token at the current position runs up to the end of the bytes read so far
+ */
+static inline int int_reader_token_open(const struct int_reader* r)
+{
+	size_t k;
+
+	for (k = r->pos; k < r->len; k++)
+	{
+		if ((unsigned char)r->data[k] <= ' ')
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * Skips whitespace; returns 1 if a token follows, 0 at the end of input
+ */
+static inline int int_reader_skip_space(struct int_reader* r)
+{
+	for (;;)
+	{
+#ifdef __SSE2__
+		const __m128i space = _mm_set1_epi8(' ');
+
+		while (r->len - r->pos >= 16)
+		{
+			__m128i v = _mm_loadu_si128((const __m128i*)(r->data + r->pos));
+			// a byte is whitespace if the unsigned maximum of it and ' ' is ' '
+			int mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, space), space)) & 0xffff;
+
+			if (mask != 0)
+			{
+				r->pos += (size_t)__builtin_ctz(mask);
+				return 1;
+			}
+			r->pos += 16;
+		}
+#endif
+		while (r->pos < r->len)
+		{
+			if ((unsigned char)r->data[r->pos] > ' ')
+			{
+				return 1;
+			}
+			r->pos++;
+		}
+		if (int_reader_fill(r) == 0)
+		{
+			return 0;
+		}
+	}
+}
+
+/*
+ * Makes sure the next n bytes of input, n at most INT_READER_BLOCK, are in data without parsing them;
+ * returns a pointer to them, or NULL if the input ends first
+ */
+static inline const char* int_reader_peek(struct int_reader* r, size_t n)
+{
+	while (r->len - r->pos < n && int_reader_fill(r) > 0)
+	{
+	}
+	return r->len - r->pos >= n ? r->data + r->pos : NULL;
+}
+
+/*
+ * Returns the number of decimal digits at the start of p, looking at no more than the n bytes there
+ */
+static inline size_t int_reader_digits(const char* p, size_t n)
+{
+	size_t k = 0;
+
+#ifdef __SSE2__
+	if (n >= 16)
+	{
+		__m128i v = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)p), _mm_set1_epi8('0'));
+		__m128i nine = _mm_set1_epi8(9);
+		// a byte is a digit if it is at most 9 once '0' is subtracted
+		int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, nine), nine));
+
+		return (size_t)__builtin_ctz(~mask);
+	}
+#endif
+	while (k < n && (unsigned char)(p[k] - '0') < 10)
+	{
+		k++;
+	}
+	return k;
+}
+
+/*
+ * Reads the next integer into *x; returns 1 on success, 0 if the next token is not an integer,
+ * EOF at the end of input
+ */
+static inline int int_reader_next(struct int_reader* r, int* x)
+{
+	const char* p;
+	size_t avail, n_digits, k;
+	unsigned long long value = 0;
+	int negative = 0;
+
+	if (!int_reader_skip_space(r))
+	{
+		return EOF;
+	}
+
+	// in block mode, make sure the whole token is in the buffer, which a pipe may deliver in pieces
+	while (!r->eof && r->len - r->pos < INT_READER_LOOKAHEAD && int_reader_token_open(r))
+	{
+		int_reader_fill(r);
+	}
+
+	p = r->data + r->pos;
+	avail = r->len - r->pos;
+
+	if (*p == '-' || *p == '+')
+	{
+		negative = (*p == '-');
+		p++;
+		avail--;
+	}
+
+	n_digits = int_reader_digits(p, avail);
+	if (n_digits == 0 || n_digits > INT_READER_DIGITS_MAX)
+	{
+		return 0;
+	}
+
+	for (k = 0; k < n_digits; k++)
+	{
+		value = value * 10 + (unsigned)(p[k] - '0');
+	}
+	if (value > (unsigned long long)INT_MAX + negative)
+	{
+		return 0;
+	}
+
+	*x = (int)(negative ? -(long long)value : (long long)value);
+	r->pos = (size_t)(p + n_digits - r->data);
+	return 1;
+}
+
+/*
+ * Reader of standard input used by read_int(), set up on first use
+ */
+static struct int_reader int_reader_stdin;
+
+/*
+ * Reads the next integer from standard input, a drop-in replacement for scanf("%d", x)
+ */
+static inline int read_int(int* x)
+{
+	if (!int_reader_stdin.open && int_reader_open(&int_reader_stdin, STDIN_FILENO) != 0)
+	{
+		return EOF;
+	}
+	return int_reader_next(&int_reader_stdin, x);
+}
+
+#endif
@@ -0,0 +1,198 @@
+/*
+ * Buffered output of integer records, shared by the programs that print large result lists.
+ * Integers are formatted straight into a large buffer instead of through one printf call each, and
+ * the buffer goes to the stream in one fwrite when it fills up or when the caller flushes it. The
+ * stream itself is given a large buffer too, so output costs a few write calls per megabyte.
+ * A record is only pushed to the operating system at its end with flush_each set, which callers
+ * enable when partial output must survive the program being killed.
+ *
+ * In binary mode, a set of vertices is written as a record of unsigned LEB128 varints: the number
+ * of vertices k, then the first vertex, then the gap from each vertex to the next, so the vertices
+ * must be in increasing order. A record with k = 0 separates groups of records.
+ *
+ * Usage: #include "../common/out_writer.h", then out_open(&w, stdout, flush_each) before anything
+ *        else is printed, out_int(&w, x) and friends, out_end_record(&w) after each record, and
+ *        out_flush(&w) before printing to the same stream with printf
+ */
+
+#ifndef OUT_WRITER_H
+#define OUT_WRITER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// bytes buffered before they are handed to the stream
+#define OUT_WRITER_BUFFER (1 << 16)
+// size of the stream's own buffer
+#define OUT_WRITER_STREAM_BUFFER (1 << 20)
+// longest formatted int or varint, with room to spare
+#define OUT_WRITER_INT_MAX 16
+
+struct out_writer
+{
+	FILE* stream; // stream written to
+	char* buf; // formatted output not yet handed to the stream
+	size_t len; // bytes in buf
+	int flush_each; // 1 to flush the stream at the end of every record
+	int binary; // 1 to write sets as varint records instead of text
+};
+
+/*
+ * Sets up a writer to stream; returns 0 on success, -1 if out of memory
+ * Must be called before anything is written to stream, as it gives the stream a larger buffer.
+ */
+static inline int out_open(struct out_writer* w, FILE* stream, int flush_each)
+{
+	memset(w, 0, sizeof(*w));
+	w->stream = stream;
+	w->flush_each = flush_each;
+	w->buf = malloc(OUT_WRITER_BUFFER);
+	if (w->buf == NULL)
+	{
+		return -1;
+	}
+	setvbuf(stream, NULL, _IOFBF, OUT_WRITER_STREAM_BUFFER);
+	return 0;
+}
+
+/*
+ * Hands the buffered output to the stream
+ */
+static inline void out_flush(struct out_writer* w)
+{
+	if (w->len > 0)
+	{
+		fwrite(w->buf, 1, w->len, w->stream);
+		w->len = 0;
+	}
+}
+
+/*
+ * Makes room for k more bytes, k being at most OUT_WRITER_BUFFER
+ */
+static inline void out_reserve(struct out_writer* w, size_t k)
+{
+	if (w->len + k > OUT_WRITER_BUFFER)
+	{
+		out_flush(w);
+	}
+}
+
+/*
+ * Writes one character
+ */
+static inline void out_char(struct out_writer* w, char c)
+{
+	out_reserve(w, 1);
+	w->buf[w->len++] = c;
+}
+
+/*
+ * Writes a string
+ */
+static inline void out_str(struct out_writer* w, const char* s)
+{
+	size_t k = strlen(s);
+
+	if (k > OUT_WRITER_BUFFER)
+	{
+		out_flush(w);
+		fwrite(s, 1, k, w->stream);
+		return;
+	}
+	out_reserve(w, k);
+	memcpy(w->buf + w->len, s, k);
+	w->len += k;
+}
+
+/*
+ * Writes an integer right-aligned in at least width characters, as printf("%*d", width, x) does
+ */
+static inline void out_int_width(struct out_writer* w, int x, int width)
+{
+	char digits[OUT_WRITER_INT_MAX];
+	unsigned u = x < 0 ? 0u - (unsigned)x : (unsigned)x;
+	int k = 0;
+
+	do
+	{
+		digits[k++] = (char)('0' + u % 10);
+		u /= 10;
+	} while (u != 0);
+	if (x < 0)
+	{
+		digits[k++] = '-';
+	}
+
+	out_reserve(w, (size_t)(k > width ? k : width));
+	for (; width > k; width--)
+	{
+		w->buf[w->len++] = ' ';
+	}
+	while (k > 0)
+	{
+		w->buf[w->len++] = digits[--k];
+	}
+}
+
+/*
+ * Writes an integer, as printf("%d", x) does
+ */
+static inline void out_int(struct out_writer* w, int x)
+{
+	out_int_width(w, x, 0);
+}
+
+/*
+ * Writes an unsigned LEB128 varint: 7 bits per byte, low bits first, the top bit set on all but the last
+ */
+static inline void out_varint(struct out_writer* w, unsigned x)
+{
+	out_reserve(w, OUT_WRITER_INT_MAX);
+	while (x >= 0x80)
+	{
+		w->buf[w->len++] = (char)((x & 0x7f) | 0x80);
+		x >>= 7;
+	}
+	w->buf[w->len++] = (char)x;
+}
+
+/*
+ * Writes a set of k vertices in increasing order as a binary record
+ */
+static inline void out_set_record(struct out_writer* w, int k, const int arr[])
+{
+	int i;
+
+	out_varint(w, (unsigned)k);
+	for (i = 0; i < k; i++)
+	{
+		out_varint(w, (unsigned)(i == 0 ? arr[0] : arr[i] - arr[i - 1]));
+	}
+}
+
+/*
+ * Ends a record: with flush_each the record goes out to the operating system at once
+ */
+static inline void out_end_record(struct out_writer* w)
+{
+	if (w->flush_each)
+	{
+		out_flush(w);
+		fflush(w->stream);
+	}
+}
+
+/*
+ * Writes out what is left and frees the buffer
+ */
+static inline void out_close(struct out_writer* w)
+{
+	out_flush(w);
+	fflush(w->stream);
+	free(w->buf);
+	w->buf = NULL;
+}
+
+#endif
@@ -0,0 +1,399 @@
+/*
+ * Permutation group given by generators, stored as a base and strong generating set
+ * The group is built with the deterministic Schreier-Sims algorithm. The base is 0, 1, ..., n - 1,
+ * and level k holds the orbit of k under the stabilizer of 0, ..., k - 1, with one coset
+ * representative per orbit point. Every element is then a unique product u_0 u_1 ... u_{n-1} of
+ * representatives, so the group can be listed one element at a time in O(n) memory per iterator,
+ * while the structure itself takes O(n) permutations per level.
+ *
+ * Usage: #include "../common/perm_group.h", then
+ *        perm_group_init(&pg, n), perm_group_add(&pg, gen) for each generator, and
+ *        perm_iter_init(&it, &pg) followed by perm_group_next(&pg, &it) until it returns NULL
+ */
+
+#ifndef PERM_GROUP_H
+#define PERM_GROUP_H
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * One level of the stabilizer chain
+ */
+struct perm_level
+{
+	int n_orbit; // number of points in the orbit of the base point
+	int* rep; // index of the representative mapping the base point to each point, -1 if none
+	int* reps; // representative r maps i to reps[r * n + i]
+	int* inv_reps; // inverses of the representatives
+	int reps_cap; // representatives reps has room for
+	int n_gens; // number of generators of the stabilizer at this level
+	int* gens; // generator g maps i to gens[g * n + i]
+	int gens_cap; // generators gens has room for
+	int* work; // pairs of a representative and a generator whose product is still to be sifted
+	int work_cap; // pairs work has room for
+	int* t; // product being sifted
+};
+
+/*
+ * Stabilizer chain of a permutation group of degree n
+ */
+struct perm_group
+{
+	int n; // degree
+	struct perm_level* level; // n levels, level k with base point k
+	int* scratch; // Schreier generator being sifted
+};
+
+/*
+ * Position in the list of elements of a group
+ */
+struct perm_iter
+{
+	int depth; // number of levels whose orbit is more than one point
+	int* levels; // those levels, from the top
+	int* index; // representative chosen at each of those levels
+	int* prefix; // prefix d is the product of the first d representatives, (depth + 1) x n entries
+	long long count; // elements listed so far
+	int done; // 1 once every element has been listed
+};
+
+/*
+ * Resizes an array to count elements of the given size; returns NULL if there is not enough memory
+ */
+static inline void* perm_resize(void* arr, size_t count, size_t size)
+{
+	void* p = realloc(arr, count * size);
+	return p == NULL && count > 0 ? NULL : p;
+}
+
+/*
+ * Sets up the trivial group of degree n; returns 0 on success, -1 if out of memory
+ */
+static inline int perm_group_init(struct perm_group* pg, int n)
+{
+	int k, i;
+
+	memset(pg, 0, sizeof(*pg));
+	pg->n = n;
+	pg->level = calloc(n, sizeof(struct perm_level));
+	pg->scratch = malloc(n * sizeof(int));
+	if (pg->level == NULL || pg->scratch == NULL)
+	{
+		return -1;
+	}
+
+	// each orbit starts as its base point, reached by the identity
+	for (k = 0; k < n; k++)
+	{
+		struct perm_level* lv = &pg->level[k];
+
+		lv->rep = malloc(n * sizeof(int));
+		lv->reps = malloc(n * sizeof(int));
+		lv->inv_reps = malloc(n * sizeof(int));
+		lv->t = malloc(n * sizeof(int));
+		if (lv->rep == NULL || lv->reps == NULL || lv->inv_reps == NULL || lv->t == NULL)
+		{
+			return -1;
+		}
+		for (i = 0; i < n; i++)
+		{
+			lv->rep[i] = -1;
+			lv->reps[i] = i;
+			lv->inv_reps[i] = i;
+		}
+		lv->rep[k] = 0;
+		lv->n_orbit = 1;
+		lv->reps_cap = 1;
+	}
+	return 0;
+}
+
+/*
+ * Sifts h through levels k onwards, leaving the residue in h
+ * Returns 1 if h is in the stabilizer of 0, ..., k - 1 built so far (the residue is the identity), 0 if not
+ */
+static inline int perm_group_sift(const struct perm_group* pg, int k, int h[])
+{
+	int n = pg->n, i, x;
+
+	for (i = k; i < n; i++)
+	{
+		const struct perm_level* lv = &pg->level[i];
+		const int* inv;
+
+		if (h[i] == i)
+		{
+			continue;
+		}
+		if (lv->rep[h[i]] < 0)
+		{
+			return 0;
+		}
+
+		// h = u^-1 h, where u is the representative mapping i to h(i)
+		inv = lv->inv_reps + (size_t)lv->rep[h[i]] * n;
+		for (x = 0; x < n; x++)
+		{
+			h[x] = inv[h[x]];
+		}
+	}
+	return 1;
+}
+
+/*
+ * Adds a generator g of the stabilizer of 0, ..., k - 1 at level k, then extends the orbit at level k and
+ * sifts the new Schreier generators into level k + 1
+ * Returns 0 on success, -1 if out of memory
+ */
+static inline int perm_group_add_at(struct perm_group* pg, int k, const int g[])
+{
+	struct perm_level* lv = &pg->level[k];
+	int n = pg->n, n_work = 0, gen, r, q, x;
+
+	if (lv->n_gens == lv->gens_cap)
+	{
+		lv->gens_cap = lv->gens_cap > 0 ? 2 * lv->gens_cap : 4;
+		lv->gens = perm_resize(lv->gens, (size_t)lv->gens_cap * n, sizeof(int));
+		if (lv->gens == NULL)
+		{
+			return -1;
+		}
+	}
+	memcpy(lv->gens + (size_t)lv->n_gens * n, g, n * sizeof(int));
+	gen = lv->n_gens++;
+
+	// the new generator applies to every point of the orbit so far
+	if (lv->work_cap < 2 * lv->n_orbit)
+	{
+		lv->work_cap = 2 * n * lv->n_gens;
+		lv->work = perm_resize(lv->work, lv->work_cap, sizeof(int));
+		if (lv->work == NULL)
+		{
+			return -1;
+		}
+	}
+	for (r = 0; r < lv->n_orbit; r++)
+	{
+		lv->work[n_work++] = r;
+		lv->work[n_work++] = gen;
+	}
+
+	while (n_work > 0)
+	{
+		const int* s;
+		const int* u;
+
+		gen = lv->work[--n_work];
+		r = lv->work[--n_work];
+		s = lv->gens + (size_t)gen * n;
+		u = lv->reps + (size_t)r * n;
+
+		// t = s u maps k to a point of the orbit
+		for (x = 0; x < n; x++)
+		{
+			lv->t[x] = s[u[x]];
+		}
+		q = lv->t[k];
+
+		if (lv->rep[q] < 0)
+		{
+			// a new orbit point, reached by t, to which every generator applies in turn
+			if (lv->n_orbit == lv->reps_cap)
+			{
+				lv->reps_cap = 2 * lv->reps_cap < n ? 2 * lv->reps_cap : n;
+				lv->reps = perm_resize(lv->reps, (size_t)lv->reps_cap * n, sizeof(int));
+				lv->inv_reps = perm_resize(lv->inv_reps, (size_t)lv->reps_cap * n, sizeof(int));
+				if (lv->reps == NULL || lv->inv_reps == NULL)
+				{
+					return -1;
+				}
+			}
+			r = lv->n_orbit++;
+			lv->rep[q] = r;
+			memcpy(lv->reps + (size_t)r * n, lv->t, n * sizeof(int));
+			for (x = 0; x < n; x++)
+			{
+				lv->inv_reps[(size_t)r * n + lv->t[x]] = x;
+			}
+
+			if (n_work + 2 * lv->n_gens > lv->work_cap)
+			{
+				lv->work_cap = 2 * (n_work + 2 * lv->n_gens);
+				lv->work = perm_resize(lv->work, lv->work_cap, sizeof(int));
+				if (lv->work == NULL)
+				{
+					return -1;
+				}
+			}
+			for (gen = 0; gen < lv->n_gens; gen++)
+			{
+				lv->work[n_work++] = r;
+				lv->work[n_work++] = gen;
+			}
+		}
+		else
+		{
+			// the Schreier generator u_q^-1 t fixes k, so it belongs one level down
+			const int* inv = lv->inv_reps + (size_t)lv->rep[q] * n;
+
+			for (x = 0; x < n; x++)
+			{
+				pg->scratch[x] = inv[lv->t[x]];
+			}
+			if (k + 1 < n && !perm_group_sift(pg, k + 1, pg->scratch) && perm_group_add_at(pg, k + 1, pg->scratch) != 0)
+			{
+				return -1;
+			}
+		}
+	}
+	return 0;
+}
+
+/*
+ * Adds a generator to the group, unless it is already an element
+ * Returns 0 on success, -1 if out of memory
+ */
+static inline int perm_group_add(struct perm_group* pg, const int g[])
+{
+	memcpy(pg->scratch, g, pg->n * sizeof(int));
+	if (perm_group_sift(pg, 0, pg->scratch))
+	{
+		return 0;
+	}
+	return perm_group_add_at(pg, 0, g);
+}
+
+/*
+ * Returns the order of the group, the product of the orbit lengths
+ */
+static inline double perm_group_order(const struct perm_group* pg)
+{
+	double order = 1;
+	int k;
+
+	for (k = 0; k < pg->n; k++)
+	{
+		order *= pg->level[k].n_orbit;
+	}
+	return order;
+}
+
+/*
+ * Sets up an iterator at the first element of a group; returns 0 on success, -1 if out of memory
+ */
+static inline int perm_iter_init(struct perm_iter* it, const struct perm_group* pg)
+{
+	int n = pg->n, k;
+
+	memset(it, 0, sizeof(*it));
+	it->levels = malloc(n * sizeof(int));
+	it->index = malloc(n * sizeof(int));
+	if (it->levels == NULL || it->index == NULL)
+	{
+		return -1;
+	}
+	for (k = 0; k < n; k++)
+	{
+		if (pg->level[k].n_orbit > 1)
+		{
+			it->levels[it->depth++] = k;
+		}
+	}
+	it->prefix = malloc((size_t)(it->depth + 1) * n * sizeof(int));
+	if (it->prefix == NULL)
+	{
+		return -1;
+	}
+	for (k = 0; k < n; k++)
+	{
+		it->prefix[k] = k;
+	}
+	return 0;
+}
+
+/*
+ * Returns the next element of the group, or NULL once every element has been listed
+ * The element stays valid until the next call. Iterators of the same group are independent, so
+ * several threads can list the group at once.
+ */
+static inline const int* perm_group_next(const struct perm_group* pg, struct perm_iter* it)
+{
+	int n = pg->n, d, x;
+
+	if (it->done)
+	{
+		return NULL;
+	}
+
+	if (it->count == 0)
+	{
+		for (d = 0; d < it->depth; d++)
+		{
+			it->index[d] = 0;
+		}
+		d = 0;
+	}
+	else
+	{
+		// advance the lowest level that has a representative left, and reset the ones below it
+		for (d = it->depth - 1; d >= 0 && ++it->index[d] == pg->level[it->levels[d]].n_orbit; d--)
+		{
+			it->index[d] = 0;
+		}
+		if (d < 0)
+		{
+			it->done = 1;
+			return NULL;
+		}
+	}
+
+	// only the products from the changed level down need recomputing
+	for (; d < it->depth; d++)
+	{
+		const int* prev = it->prefix + (size_t)d * n;
+		const int* u = pg->level[it->levels[d]].reps + (size_t)it->index[d] * n;
+		int* next = it->prefix + (size_t)(d + 1) * n;
+
+		for (x = 0; x < n; x++)
+		{
+			next[x] = prev[u[x]];
+		}
+	}
+	it->count++;
+	return it->prefix + (size_t)it->depth * n;
+}
+
+/*
+ * Frees an iterator
+ */
+static inline void perm_iter_free(struct perm_iter* it)
+{
+	free(it->levels);
+	free(it->index);
+	free(it->prefix);
+	memset(it, 0, sizeof(*it));
+}
+
+/*
+ * Frees a group
+ */
+static inline void perm_group_free(struct perm_group* pg)
+{
+	int k;
+
+	for (k = 0; pg->level != NULL && k < pg->n; k++)
+	{
+		free(pg->level[k].rep);
+		free(pg->level[k].reps);
+		free(pg->level[k].inv_reps);
+		free(pg->level[k].gens);
+		free(pg->level[k].work);
+		free(pg->level[k].t);
+	}
+	free(pg->level);
+	free(pg->scratch);
+	memset(pg, 0, sizeof(*pg));
+}
+
+#endif